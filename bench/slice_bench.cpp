@@ -0,0 +1,303 @@
+/*
+Author: Blake Brown
+*/
+/*
+A standalone benchmark of the functions generated by define_slice, next to std::vector and std::deque doing the same work.
+It needs nothing but a C++11 compiler, build and run it from the root of the repository with
+```
+    g++ -O2 -std=c++11 -I. bench/slice_bench.cpp -o slice_bench
+    ./slice_bench --format=json > results.json
+```
+Options:
+    --n=N            elements per run for append, random_at, pop, resize and churn (default 1048576)
+    --front-n=N      elements per run for front_append and front_pop, they are O(length) per call on a slice (default 4096)
+    --batch=N        ops timed together for one latency sample (default 16), the clock is too coarse to time a single op
+    --format=F       text (default), csv or json
+    --filter=S       only runs benchmarks whose "container/op/size" contains S, e.g. --filter=slice/append
+
+Every benchmark is run for element sizes of 1, 8, 64 and 256 bytes and reports the throughput (ops per second over the
+whole run) and the p50 and p99 of the per op latency (the time of a batch divided by the batch size).
+churn makes a slice, appends 16 elements and destroys it (one op), resize jumps between random lengths up to 1024.
+*/
+#include "slice.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <string>
+#include <vector>
+
+typedef struct elem_1 { unsigned char bytes[1]; } elem_1;
+typedef struct elem_8 { unsigned char bytes[8]; } elem_8;
+typedef struct elem_64 { unsigned char bytes[64]; } elem_64;
+typedef struct elem_256 { unsigned char bytes[256]; } elem_256;
+
+define_slice(slice_1,elem_1);
+define_slice(slice_8,elem_8);
+define_slice(slice_64,elem_64);
+define_slice(slice_256,elem_256);
+
+//c_slice<type> forwards to the functions define_slice generated for $type so one template can drive every size.
+template<class T> struct c_slice;
+#define BENCH_C_SLICE(name,type) template<> struct c_slice<type> {\
+    typedef name slice_type;\
+    static name make(size_t cap){return ___slice_function_name___(make,name)(cap);}\
+    static void destroy(name* s){___slice_function_name___(destroy,name)(s);}\
+    static int append(name* s,type v){return ___slice_function_name___(append,name)(s,v);}\
+    static int front_append(name* s,type v){return ___slice_function_name___(front_append,name)(s,v);}\
+    static type at(name* s,size_t i){return ___slice_function_name___(at,name)(s,i);}\
+    static int pop(name* s,type* out){return ___slice_function_name___(pop,name)(s,out);}\
+    static int front_pop(name* s,type* out){return ___slice_function_name___(front_pop,name)(s,out);}\
+    static int resize(name* s,size_t n){return ___slice_function_name___(resize,name)(s,n);}\
+}
+BENCH_C_SLICE(slice_1,elem_1);
+BENCH_C_SLICE(slice_8,elem_8);
+BENCH_C_SLICE(slice_64,elem_64);
+BENCH_C_SLICE(slice_256,elem_256);
+
+//resize jumps between random lengths up to this, a std container initializes every element it grows by
+//so larger jumps would measure memset instead of the resize.
+#define SLICE_BENCH_RESIZE_MAX 1024
+
+struct options {
+    size_t n;
+    size_t front_n;
+    size_t batch;
+    std::string format;
+    std::string filter;
+};
+
+struct result {
+    std::string container;
+    std::string op;
+    size_t elem_size;
+    size_t ops;
+    double ops_per_sec;
+    double p50_ns;
+    double p99_ns;
+};
+
+static options opts;
+static std::vector<result> results;
+static volatile unsigned sink;
+
+template<class T>
+static T make_elem(size_t i){
+    T out;
+    std::memset(&out,0,sizeof(out));
+    out.bytes[0] = (unsigned char)i;
+    return out;
+}
+
+static bool selected(const char* container,const char* op,size_t elem_size){
+    char id[128];
+    std::snprintf(id,sizeof(id),"%s/%s/%zu",container,op,elem_size);
+    return opts.filter.empty() || std::strstr(id,opts.filter.c_str()) != NULL;
+}
+
+static double percentile(std::vector<double>& samples,double p){
+    if(samples.empty()){return 0;}
+    size_t at = (size_t)(p*(double)(samples.size() - 1));
+    std::nth_element(samples.begin(),samples.begin() + at,samples.end());
+    return samples[at];
+}
+
+//runs step(i) for i in [0,ops) in batches of opts.batch and records the throughput and latency percentiles.
+template<class Step>
+static void measure(const char* container,const char* op,size_t elem_size,size_t ops,Step step){
+    typedef std::chrono::steady_clock clock;
+    std::vector<double> samples;
+    samples.reserve(ops/opts.batch + 1);
+    clock::time_point start = clock::now();
+    for(size_t i = 0;i < ops;){
+        size_t end = std::min(ops,i + opts.batch);
+        size_t count = end - i;
+        clock::time_point t0 = clock::now();
+        for(;i < end;i++){step(i);}
+        clock::time_point t1 = clock::now();
+        samples.push_back(std::chrono::duration<double,std::nano>(t1 - t0).count()/(double)count);
+    }
+    double total = std::chrono::duration<double>(clock::now() - start).count();
+    result r;
+    r.container = container;
+    r.op = op;
+    r.elem_size = elem_size;
+    r.ops = ops;
+    r.ops_per_sec = total > 0 ? (double)ops/total : 0;
+    r.p50_ns = percentile(samples,0.50);
+    r.p99_ns = percentile(samples,0.99);
+    results.push_back(r);
+}
+
+//random indices below len, the same sequence for every container.
+static std::vector<size_t> random_indices(size_t count,size_t len){
+    std::vector<size_t> out(count);
+    unsigned long long x = 0x9E3779B97F4A7C15ull;
+    for(size_t i = 0;i < count;i++){
+        x ^= x << 13;x ^= x >> 7;x ^= x << 17;
+        out[i] = len ? (size_t)(x % len) : 0;
+    }
+    return out;
+}
+
+template<class T>
+static void bench_slice(){
+    typedef c_slice<T> ops;
+    typedef typename ops::slice_type slice_type;
+    const size_t n = opts.n,front_n = opts.front_n,size = sizeof(T);
+    if(selected("slice","append",size)){
+        slice_type s = ops::make(0);
+        measure("slice","append",size,n,[&](size_t i){ops::append(&s,make_elem<T>(i));});
+        ops::destroy(&s);
+    }
+    if(selected("slice","front_append",size)){
+        slice_type s = ops::make(0);
+        measure("slice","front_append",size,front_n,[&](size_t i){ops::front_append(&s,make_elem<T>(i));});
+        ops::destroy(&s);
+    }
+    if(selected("slice","front_pop",size)){
+        slice_type s = ops::make(front_n);
+        for(size_t i = 0;i < front_n;i++){ops::append(&s,make_elem<T>(i));}
+        T out = T();
+        measure("slice","front_pop",size,front_n,[&](size_t){ops::front_pop(&s,&out);sink += out.bytes[0];});
+        ops::destroy(&s);
+    }
+    if(selected("slice","random_at",size)){
+        slice_type s = ops::make(n);
+        for(size_t i = 0;i < n;i++){ops::append(&s,make_elem<T>(i));}
+        std::vector<size_t> at = random_indices(n,n);
+        measure("slice","random_at",size,n,[&](size_t i){sink += ops::at(&s,at[i]).bytes[0];});
+        ops::destroy(&s);
+    }
+    if(selected("slice","pop",size)){
+        slice_type s = ops::make(n);
+        for(size_t i = 0;i < n;i++){ops::append(&s,make_elem<T>(i));}
+        T out = T();
+        measure("slice","pop",size,n,[&](size_t){ops::pop(&s,&out);sink += out.bytes[0];});
+        ops::destroy(&s);
+    }
+    if(selected("slice","resize",size)){
+        slice_type s = ops::make(0);
+        std::vector<size_t> to = random_indices(n,SLICE_BENCH_RESIZE_MAX + 1);
+        measure("slice","resize",size,n,[&](size_t i){ops::resize(&s,to[i]);});
+        ops::destroy(&s);
+    }
+    if(selected("slice","churn",size)){
+        measure("slice","churn",size,n/16,[&](size_t i){
+            slice_type s = ops::make(16);
+            for(size_t j = 0;j < 16;j++){ops::append(&s,make_elem<T>(i + j));}
+            sink += ops::at(&s,15).bytes[0];
+            ops::destroy(&s);
+        });
+    }
+}
+
+//the std::vector and std::deque baselines, front ops on a vector insert and erase at begin().
+template<class T,class C>
+static void bench_std(const char* container){
+    const size_t n = opts.n,front_n = opts.front_n,size = sizeof(T);
+    if(selected(container,"append",size)){
+        C c;
+        measure(container,"append",size,n,[&](size_t i){c.push_back(make_elem<T>(i));});
+    }
+    if(selected(container,"front_append",size)){
+        C c;
+        measure(container,"front_append",size,front_n,[&](size_t i){c.insert(c.begin(),make_elem<T>(i));});
+    }
+    if(selected(container,"front_pop",size)){
+        C c;
+        for(size_t i = 0;i < front_n;i++){c.push_back(make_elem<T>(i));}
+        measure(container,"front_pop",size,front_n,[&](size_t){sink += c.front().bytes[0];c.erase(c.begin());});
+    }
+    if(selected(container,"random_at",size)){
+        C c;
+        for(size_t i = 0;i < n;i++){c.push_back(make_elem<T>(i));}
+        std::vector<size_t> at = random_indices(n,n);
+        measure(container,"random_at",size,n,[&](size_t i){sink += c[at[i]].bytes[0];});
+    }
+    if(selected(container,"pop",size)){
+        C c;
+        for(size_t i = 0;i < n;i++){c.push_back(make_elem<T>(i));}
+        measure(container,"pop",size,n,[&](size_t){sink += c.back().bytes[0];c.pop_back();});
+    }
+    if(selected(container,"resize",size)){
+        C c;
+        std::vector<size_t> to = random_indices(n,SLICE_BENCH_RESIZE_MAX + 1);
+        measure(container,"resize",size,n,[&](size_t i){c.resize(to[i]);});
+    }
+    if(selected(container,"churn",size)){
+        measure(container,"churn",size,n/16,[&](size_t i){
+            C c;
+            for(size_t j = 0;j < 16;j++){c.push_back(make_elem<T>(i + j));}
+            sink += c[15].bytes[0];
+        });
+    }
+}
+
+template<class T>
+static void bench_size(){
+    bench_slice<T>();
+    bench_std<T,std::vector<T> >("std::vector");
+    bench_std<T,std::deque<T> >("std::deque");
+}
+
+static void print_results(){
+    if(opts.format == "json"){
+        std::printf("[\n");
+        for(size_t i = 0;i < results.size();i++){
+            const result& r = results[i];
+            std::printf("  {\"container\":\"%s\",\"op\":\"%s\",\"elem_size\":%zu,\"ops\":%zu,\"ops_per_sec\":%.1f,\"p50_ns\":%.2f,\"p99_ns\":%.2f}%s\n",
+                r.container.c_str(),r.op.c_str(),r.elem_size,r.ops,r.ops_per_sec,r.p50_ns,r.p99_ns,i + 1 < results.size() ? "," : "");
+        }
+        std::printf("]\n");
+        return;
+    }
+    if(opts.format == "csv"){
+        std::printf("container,op,elem_size,ops,ops_per_sec,p50_ns,p99_ns\n");
+        for(size_t i = 0;i < results.size();i++){
+            const result& r = results[i];
+            std::printf("%s,%s,%zu,%zu,%.1f,%.2f,%.2f\n",r.container.c_str(),r.op.c_str(),r.elem_size,r.ops,r.ops_per_sec,r.p50_ns,r.p99_ns);
+        }
+        return;
+    }
+    std::printf("%-12s %-13s %5s %10s %14s %10s %10s\n","container","op","size","ops","ops/s","p50 ns","p99 ns");
+    for(size_t i = 0;i < results.size();i++){
+        const result& r = results[i];
+        std::printf("%-12s %-13s %5zu %10zu %14.0f %10.2f %10.2f\n",r.container.c_str(),r.op.c_str(),r.elem_size,r.ops,r.ops_per_sec,r.p50_ns,r.p99_ns);
+    }
+}
+
+static bool parse_size(const char* arg,const char* prefix,size_t* out){
+    size_t len = std::strlen(prefix);
+    if(std::strncmp(arg,prefix,len) != 0){return false;}
+    *out = (size_t)std::strtoull(arg + len,NULL,10);
+    return true;
+}
+
+int main(int argc,char** argv){
+    opts.n = 1 << 20;
+    opts.front_n = 4096;
+    opts.batch = 16;
+    opts.format = "text";
+    for(int i = 1;i < argc;i++){
+        const char* arg = argv[i];
+        if(parse_size(arg,"--n=",&opts.n)||parse_size(arg,"--front-n=",&opts.front_n)||parse_size(arg,"--batch=",&opts.batch)){continue;}
+        if(std::strncmp(arg,"--format=",9) == 0){opts.format = arg + 9;continue;}
+        if(std::strncmp(arg,"--filter=",9) == 0){opts.filter = arg + 9;continue;}
+        std::fprintf(stderr,"usage: %s [--n=N] [--front-n=N] [--batch=N] [--format=text|csv|json] [--filter=S]\n",argv[0]);
+        return 2;
+    }
+    if(opts.batch == 0){opts.batch = 1;}
+    if(opts.format != "text" && opts.format != "csv" && opts.format != "json"){
+        std::fprintf(stderr,"unknown format %s\n",opts.format.c_str());
+        return 2;
+    }
+    bench_size<elem_1>();
+    bench_size<elem_8>();
+    bench_size<elem_64>();
+    bench_size<elem_256>();
+    print_results();
+    return 0;
+}
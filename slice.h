@@ -116,6 +116,47 @@ int $name_cap(name the_thing);
 //returns 1 on success and 0 on error 
 int $name_resize($name* slice,size_t new_len);
 
+//int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+//the array is grown at most once and the items are copied with a single memcpy, src must not point into the slice.
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+
+//int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+//returns 0 on failure and 1 on success, the array is grown at most once, src must not point into the slice.
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n);
+
+//int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice,
+//returns 0 on failure and 1 on success.
+int $name_erase_range ($name* the_thing,size_t first,size_t last);
+
+//int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+//returns 0 on failure and 1 on success.
+int $name_reserve ($name* the_thing,size_t new_cap);
+
+//int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+//the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+int $name_grow ($name* the_thing,size_t needed);
+
+//int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+//returns 0 on failure and 1 on success.
+int $name_shrink_to_fit ($name* the_thing);
+
+//$name_view is a non-owning view {type* data;size_t len;} of elements owned by something else,
+//it is invalidated by anything that grows, shrinks or destroys the slice it views.
+//$name_view $name_as_view($name* the_thing) views the whole slice, $name_view $name_subslice($name* the_thing,size_t from,size_t to)
+//views the elements [from,to) without copying them (empty view with NULL data if the range is invalid).
+$name_view $name_as_view($name* the_thing);
+$name_view $name_subslice($name* the_thing,size_t from,size_t to);
+
+//$name_view $name_view_make(type* data,size_t len) views len elements starting at data,
+//$name_view_subslice, $name_view_at and $name_view_bounded_at work like $name_subslice, $name_at and $name_bounded_at on a view.
+$name_view $name_view_make(type* data,size_t len);
+$name_view $name_view_subslice($name_view view,size_t from,size_t to);
+$type $name_view_at($name_view view,size_t index);
+int $name_view_bounded_at($name_view view,size_t index,type* result);
+
+//int $name_view_equal($name_view a,$name_view b) returns 1 if both views have the same length and bytes, 0 otherwise.
+int $name_view_equal($name_view a,$name_view b);
+
 
 
 If you want more control... 
@@ -124,6 +165,9 @@ by defining the macros before usage of macros
 SLICE_DATA_VARAIABLE_NAME  //default: data 
 SLICE_LENGTH_VARAIABLE_NAME & //default: len 
 SLICE_CAPACITY_VARAIABLE_NAME //default: cap
+SLICE_HEAD_VARAIABLE_NAME //default: head (deque slices only)
+SLICE_INLINE_VARAIABLE_NAME //default: inline_data (small buffer slices only)
+SLICE_ALLOCATOR_VARAIABLE_NAME //default: allocator (allocator slices only)
 
 you may optionally use any macro ending in _decl to create a declaration
 for that accessor function and the same macro that does not end in _decl to create the definition.
@@ -152,6 +196,11 @@ You must also
 #define SLICE_UNSAFE_CALLOC_ALLOCATOR custom_calloc
 #define SLICE_UNSAFE_REALLOC_ALLOCATOR realloc
 #define SLICE_UNSAFE_FREE_ALLOCATOR free
+If you do not want <string.h> to be included, you must also
+#define SLICE_UNSAFE_MEMMOVE custom_memmove
+#define SLICE_UNSAFE_MEMCPY custom_memcpy
+#define SLICE_UNSAFE_MEMSET custom_memset
+#define SLICE_UNSAFE_MEMCMP custom_memcmp
 */
 #endif
 //the calloc function to be used by this library
@@ -182,6 +231,18 @@ You must also
 #define SLICE_CAPACITY_VARAIABLE_NAME cap
 #endif
 
+#ifndef SLICE_HEAD_VARAIABLE_NAME
+#define SLICE_HEAD_VARAIABLE_NAME head
+#endif
+
+#ifndef SLICE_INLINE_VARAIABLE_NAME
+#define SLICE_INLINE_VARAIABLE_NAME inline_data
+#endif
+
+#ifndef SLICE_ALLOCATOR_VARAIABLE_NAME
+#define SLICE_ALLOCATOR_VARAIABLE_NAME allocator
+#endif
+
 
 #ifndef slice_calloc
 //slice_calloc is the calloc function to be used by this library,
@@ -214,6 +275,428 @@ You must also
 #define slice_realloc(type,data,cap) (type*)SLICE_UNSAFE_REALLOC_ALLOCATOR(data,cap*sizeof(type))
 #endif
 
+//the memmove function to be used by this library
+#ifndef SLICE_UNSAFE_MEMMOVE
+#include <string.h>
+//the memmove function to be used by this library
+#define SLICE_UNSAFE_MEMMOVE memmove
+#endif
+
+//the memcpy function to be used by this library
+#ifndef SLICE_UNSAFE_MEMCPY
+#include <string.h>
+//the memcpy function to be used by this library
+#define SLICE_UNSAFE_MEMCPY memcpy
+#endif
+
+#ifndef slice_memcpy
+//slice_memcpy is the memcpy function to be used by this library,
+//it copies count objects of type $type from src to dst, the ranges must not overlap.
+#define slice_memcpy(type,dst,src,count) SLICE_UNSAFE_MEMCPY((dst),(src),(count)*sizeof(type))
+#endif
+
+//the memcmp function to be used by this library
+#ifndef SLICE_UNSAFE_MEMCMP
+#include <string.h>
+//the memcmp function to be used by this library
+#define SLICE_UNSAFE_MEMCMP memcmp
+#endif
+
+//the memset function to be used by this library
+#ifndef SLICE_UNSAFE_MEMSET
+#include <string.h>
+//the memset function to be used by this library
+#define SLICE_UNSAFE_MEMSET memset
+#endif
+
+#ifndef slice_memmove
+//slice_memmove is the memmove function to be used by this library,
+//it moves count objects of type $type from src to dst, the ranges may overlap.
+#define slice_memmove(type,dst,src,count) SLICE_UNSAFE_MEMMOVE((dst),(src),(count)*sizeof(type))
+#endif
+
+/*
+Growth policies.
+A growth policy is a function (or function like macro) size_t policy(size_t cap,size_t needed,size_t elem_size)
+that returns the new capacity of a slice holding cap elements of elem_size bytes that must hold at least needed elements.
+Every function that grows a slice ($name_append,$name_front_append,$name_append_n,$name_insert_n,$name_resize...)
+asks SLICE_GROWTH_POLICY for the new capacity.
+SLICE_GROWTH_POLICY is expanded when the slice functions are defined (define_slice,define_slice_definitions,...),
+so you may choose a different policy for each slice type by redefining it before defining the slice.
+Example
+```
+    #undef SLICE_GROWTH_POLICY
+    #define SLICE_GROWTH_POLICY slice_growth_page_rounded
+    define_slice(big_slice,double);
+    #undef SLICE_GROWTH_POLICY
+    #define SLICE_GROWTH_POLICY slice_growth_geometric_1_5x
+    define_slice(small_slice,int);
+```
+The following policies are provided:
+slice_growth_geometric_2x   doubles the capacity (default).
+slice_growth_geometric_1_5x grows the capacity by 1.5x, less memory overhead, more reallocations.
+slice_growth_page_rounded   grows by 1.5x (like slice_growth_geometric_1_5x) and rounds the allocation up to a multiple of SLICE_PAGE_SIZE
+                            once it is bigger than a page.
+slice_growth_size_class     grows by 1.5x and rounds the allocation up to a jemalloc style size class (4 classes per power of two),
+                            so the memory the allocator hands out is never wasted.
+*/
+#ifndef SLICE_PAGE_SIZE
+//the page size used by slice_growth_page_rounded
+#define SLICE_PAGE_SIZE 4096
+#endif
+
+static inline size_t slice_growth_geometric_2x(size_t cap,size_t needed,size_t elem_size){
+    size_t new_cap = cap*2;
+    (void)elem_size;
+    return new_cap < needed ? needed : new_cap;
+}
+
+static inline size_t slice_growth_geometric_1_5x(size_t cap,size_t needed,size_t elem_size){
+    size_t new_cap = cap + cap/2 + 1;
+    (void)elem_size;
+    return new_cap < needed ? needed : new_cap;
+}
+
+static inline size_t slice_growth_page_rounded(size_t cap,size_t needed,size_t elem_size){
+    size_t new_cap = slice_growth_geometric_1_5x(cap,needed,elem_size);
+    size_t bytes = new_cap*elem_size;
+    if(bytes <= SLICE_PAGE_SIZE || elem_size == 0){return new_cap;}
+    bytes = (bytes + SLICE_PAGE_SIZE - 1) / SLICE_PAGE_SIZE * SLICE_PAGE_SIZE;
+    return bytes / elem_size;
+}
+
+static inline size_t slice_growth_size_class(size_t cap,size_t needed,size_t elem_size){
+    size_t bytes = slice_growth_geometric_1_5x(cap,needed,elem_size)*elem_size;
+    size_t step = 1;
+    if(elem_size == 0){return slice_growth_geometric_1_5x(cap,needed,elem_size);}
+    if(bytes <= 16){return 16 / elem_size < needed ? needed : 16 / elem_size;}
+    while((step << 3) < bytes){step <<= 1;}
+    bytes = (bytes + step - 1) / step * step;
+    return bytes / elem_size;
+}
+
+/*
+Allocation failures.
+Functions that grow a slice allocate the new storage first and only update the data pointer, length and capacity
+once the allocation succeeded, if it fails they return 0 and leave the slice exactly as it was (nothing is leaked).
+If your allocator never returns NULL (it aborts on out of memory instead), you may
+#define SLICE_NOALLOC_FAIL
+before including this file, the NULL checks after the allocations are then compiled out so the growing functions stay branch light.
+Growing can still fail for reasons that are not allocations (a capacity larger than slice_max_cap, a read only memory
+mapped slice, a file that couldn't be extended), so the result of the grow functions is always checked.
+*/
+#ifdef SLICE_NOALLOC_FAIL
+//slice_alloc_failed(ptr) is 1 if the allocation that returned ptr failed, always 0 with SLICE_NOALLOC_FAIL.
+#define slice_alloc_failed(ptr) 0
+#else
+//slice_alloc_failed(ptr) is 1 if the allocation that returned ptr failed, always 0 with SLICE_NOALLOC_FAIL.
+#define slice_alloc_failed(ptr) ((ptr) == NULL)
+#endif
+//slice_grow_failed(grow_call) evaluates a call that grows a slice and is 1 if it failed (also with SLICE_NOALLOC_FAIL).
+#define slice_grow_failed(grow_call) (!(grow_call))
+
+//the largest number of objects of type $type a slice may hold without overflowing size_t when computing its size in bytes.
+#define slice_max_cap(type) (((size_t)-1)/sizeof(type))
+
+#ifndef SLICE_CACHE_LINE_SIZE
+//the size of a cache line, fields written by different threads are kept this many bytes apart
+//and search layouts are blocked to this size
+#define SLICE_CACHE_LINE_SIZE 64
+#endif
+
+#if defined(__GNUC__) || defined(__clang__)
+//hints the cpu to start loading the cache line holding ptr
+#define slice_prefetch(ptr) __builtin_prefetch(ptr)
+#else
+#define slice_prefetch(ptr) ((void)0)
+#endif
+
+#ifndef SLICE_GROWTH_POLICY
+//the growth policy used by slices defined after this point, see the note above.
+#define SLICE_GROWTH_POLICY slice_growth_geometric_2x
+#endif
+
+/*
+Statistics.
+If you
+#define SLICE_ENABLE_STATS
+before including this file (it then needs C11 or C++11 atomics and thread locals, see slice_atomic.h), every slice type
+defined with define_slice, define_slice_with_allocator or define_slice_mmap counts what its functions do:
+
+SLICE_STATS_MAKES          slices made with $name_make/$name_make_raw
+SLICE_STATS_DESTROYS       slices destroyed
+SLICE_STATS_APPENDS        elements added by $name_append,$name_front_append,$name_append_n and $name_insert_n
+SLICE_STATS_REALLOCS       reallocations of the storage (growing and $name_shrink_to_fit)
+SLICE_STATS_BYTES_COPIED   bytes copied because a reallocation moved the storage
+SLICE_STATS_PEAK_CAP       the largest capacity a slice of the type had
+SLICE_STATS_FRONT_SHIFTS   elements moved to make or close a gap ($name_front_append,$name_front_pop,$name_insert_n,$name_erase_range)
+SLICE_STATS_WASTED_BYTES   bytes of capacity that were never used when slices were destroyed
+
+Every thread counts into its own block of counters with plain loads and stores (no locked instructions),
+the blocks are only summed when the statistics are read, so the counts of threads that are still running may be slightly behind.
+When a thread exits its blocks keep their counts and are handed to the next thread that counts for the same type,
+so a program allocates one block per type per thread running at once, not per thread ever started
+(this needs pthreads, on Windows every thread keeps its own block).
+A type registers itself the first time it counts something.
+Only the types above count, deque, small buffer, segmented, soa, bitset, concurrent and cow slices don't.
+```
+    slice_stats s;
+    if(slice_stats_get("ints",&s)){printf("%zu reallocs\n",s.counters[SLICE_STATS_REALLOCS]);}
+    slice_stats_print(stderr);          one line per type
+    slice_stats_print_json(file);       [{"name":"ints","elem_size":4,"makes":1,...}]
+```
+With gcc and clang the registry is shared by every translation unit, other compilers get one registry per translation unit.
+Without SLICE_ENABLE_STATS the counting compiles to nothing.
+*/
+#ifdef SLICE_ENABLE_STATS
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include "slice_atomic.h"
+#if !defined(_WIN32)
+#define SLICE_STATS_RECYCLE 1
+#include <pthread.h>
+#endif
+
+enum {
+    SLICE_STATS_MAKES,
+    SLICE_STATS_DESTROYS,
+    SLICE_STATS_APPENDS,
+    SLICE_STATS_REALLOCS,
+    SLICE_STATS_BYTES_COPIED,
+    SLICE_STATS_PEAK_CAP,
+    SLICE_STATS_FRONT_SHIFTS,
+    SLICE_STATS_WASTED_BYTES,
+    SLICE_STATS_COUNT
+};
+
+//the counters of one slice type in one thread
+typedef struct slice_stats_local {
+    slice_atomic(size_t) counters[SLICE_STATS_COUNT];
+    struct slice_stats_local* next;
+    slice_atomic(int) in_use; //0 once the thread that counted into it exited
+    struct slice_stats_local* thread_next; //the next block of the same thread
+    struct slice_stats_local** slot; //the thread local pointer of the thread to this block
+} slice_stats_local;
+
+//a slice type that counts statistics, defined by define_slice_stats
+typedef struct slice_stats_type {
+    const char* name;
+    size_t elem_size;
+    slice_atomic(slice_stats_local*) locals;
+    slice_atomic(int) registered;
+    struct slice_stats_type* next;
+} slice_stats_type;
+
+//the counters of a slice type summed over every thread
+typedef struct slice_stats {
+    const char* name;
+    size_t elem_size;
+    size_t counters[SLICE_STATS_COUNT];
+} slice_stats;
+
+#if defined(__GNUC__) || defined(__clang__)
+#define SLICE_STATS_SHARED __attribute__((weak))
+#else
+#define SLICE_STATS_SHARED static
+#endif
+
+//the list of every slice type that counted something
+SLICE_C_BEGIN SLICE_STATS_SHARED slice_atomic(slice_stats_type*) slice_stats_registry; SLICE_C_END
+
+#ifdef SLICE_STATS_RECYCLE
+//the key whose value is the list of blocks of a thread, its destructor frees them for reuse when the thread exits
+SLICE_C_BEGIN SLICE_STATS_SHARED pthread_once_t slice_stats_key_once = PTHREAD_ONCE_INIT; SLICE_C_END
+SLICE_C_BEGIN SLICE_STATS_SHARED pthread_key_t slice_stats_key; SLICE_C_END
+SLICE_C_BEGIN SLICE_STATS_SHARED int slice_stats_key_ok; SLICE_C_END
+
+//hands the blocks of an exiting thread to the next threads that attach, their counts stay part of the sums
+static inline void slice_stats_detach(void* blocks){
+    slice_stats_local* local = (slice_stats_local*)blocks;
+    slice_stats_local* next;
+    while(local != NULL){
+        next = local->thread_next;
+        *local->slot = NULL;
+        slice_atomic_store(&local->in_use,0,release);
+        local = next;
+    }
+}
+
+static inline void slice_stats_key_create(void){
+    slice_stats_key_ok = pthread_key_create(&slice_stats_key,slice_stats_detach) == 0;
+}
+#endif
+
+//returns the name of a counter as used by slice_stats_print and slice_stats_print_json
+static inline const char* slice_stats_counter_name(int counter){
+    switch(counter){
+        case SLICE_STATS_MAKES: return "makes";
+        case SLICE_STATS_DESTROYS: return "destroys";
+        case SLICE_STATS_APPENDS: return "appends";
+        case SLICE_STATS_REALLOCS: return "reallocs";
+        case SLICE_STATS_BYTES_COPIED: return "bytes_copied";
+        case SLICE_STATS_PEAK_CAP: return "peak_cap";
+        case SLICE_STATS_FRONT_SHIFTS: return "front_shifts";
+        case SLICE_STATS_WASTED_BYTES: return "wasted_bytes";
+        default: return "unknown";
+    }
+}
+
+//gives the calling thread a block of counters for a type (one an exited thread left if there is one) and registers the type,
+//slot is the thread local pointer the block is stored in. returns NULL if it can't be allocated.
+static inline slice_stats_local* slice_stats_attach(slice_stats_type* type,const char* name,size_t elem_size,slice_stats_local** slot){
+    slice_stats_local* local;
+    slice_stats_local* head;
+    slice_stats_type* types;
+    int unregistered = 0;
+    int i;
+#ifdef SLICE_STATS_RECYCLE
+    int unused;
+    pthread_once(&slice_stats_key_once,slice_stats_key_create);
+    if(slice_stats_key_ok){
+        for(local = slice_atomic_load(&type->locals,acquire);local != NULL;local = local->next){
+            unused = 0;
+            if(slice_atomic_load(&local->in_use,relaxed) == 0 && slice_atomic_compare_exchange(&local->in_use,&unused,1,acquire)){break;}
+        }
+        if(local != NULL){
+            local->slot = slot;
+            local->thread_next = (slice_stats_local*)pthread_getspecific(slice_stats_key);
+            if(pthread_setspecific(slice_stats_key,local) == 0){return local;}
+            slice_atomic_store(&local->in_use,0,release);
+            return NULL;
+        }
+    }
+#endif
+    local = (slice_stats_local*)SLICE_UNSAFE_CALLOC_ALLOCATOR(1,sizeof(slice_stats_local));
+    if(local == NULL){return NULL;}
+    for(i = 0;i < SLICE_STATS_COUNT;i++){slice_atomic_init(&local->counters[i],0);}
+    slice_atomic_init(&local->in_use,1);
+    local->slot = slot;
+#ifdef SLICE_STATS_RECYCLE
+    //a block that can't be put in the list of the thread is never handed to another thread
+    if(slice_stats_key_ok){
+        local->thread_next = (slice_stats_local*)pthread_getspecific(slice_stats_key);
+        if(pthread_setspecific(slice_stats_key,local) != 0){local->thread_next = NULL;}
+    }
+#endif
+    head = slice_atomic_load(&type->locals,relaxed);
+    do{local->next = head;}while(!slice_atomic_compare_exchange(&type->locals,&head,local,release));
+    if(slice_atomic_compare_exchange(&type->registered,&unregistered,1,relaxed)){
+        type->name = name;
+        type->elem_size = elem_size;
+        types = slice_atomic_load(&slice_stats_registry,relaxed);
+        do{type->next = types;}while(!slice_atomic_compare_exchange(&slice_stats_registry,&types,type,release));
+    }
+    return local;
+}
+
+//adds value to a counter of the calling thread
+static inline void slice_stats_bump(slice_stats_local* local,int counter,size_t value){
+    if(local == NULL){return;}
+    slice_atomic_store(&local->counters[counter],slice_atomic_load(&local->counters[counter],relaxed) + value,relaxed);
+}
+
+//raises a counter of the calling thread to value if it is lower
+static inline void slice_stats_raise(slice_stats_local* local,int counter,size_t value){
+    if(local == NULL||slice_atomic_load(&local->counters[counter],relaxed) >= value){return;}
+    slice_atomic_store(&local->counters[counter],value,relaxed);
+}
+
+//sums the counters of a type over every thread into out
+static inline void slice_stats_sum(slice_stats_type* type,slice_stats* out){
+    slice_stats_local* local;
+    size_t value;
+    int i;
+    out->name = type->name;
+    out->elem_size = type->elem_size;
+    for(i = 0;i < SLICE_STATS_COUNT;i++){out->counters[i] = 0;}
+    for(local = slice_atomic_load(&type->locals,acquire);local != NULL;local = local->next){
+        for(i = 0;i < SLICE_STATS_COUNT;i++){
+            value = slice_atomic_load(&local->counters[i],relaxed);
+            if(i == SLICE_STATS_PEAK_CAP){out->counters[i] = value > out->counters[i] ? value : out->counters[i];}
+            else{out->counters[i] += value;}
+        }
+    }
+}
+
+//int slice_stats_get(const char* name,slice_stats* out) fills out with the statistics of the slice type named name,
+//returns 0 if no such type counted anything yet.
+static inline int slice_stats_get(const char* name,slice_stats* out){
+    slice_stats_type* type;
+    for(type = slice_atomic_load(&slice_stats_registry,acquire);type != NULL;type = type->next){
+        if(strcmp(type->name,name) == 0){slice_stats_sum(type,out);return 1;}
+    }
+    return 0;
+}
+
+//void slice_stats_print(FILE* out) prints the statistics of every slice type, one line per type.
+static inline void slice_stats_print(FILE* out){
+    slice_stats_type* type;
+    slice_stats stats;
+    int i;
+    for(type = slice_atomic_load(&slice_stats_registry,acquire);type != NULL;type = type->next){
+        slice_stats_sum(type,&stats);
+        fprintf(out,"%s (%zu bytes):",stats.name,stats.elem_size);
+        for(i = 0;i < SLICE_STATS_COUNT;i++){fprintf(out," %s=%zu",slice_stats_counter_name(i),stats.counters[i]);}
+        fprintf(out,"\n");
+    }
+}
+
+//void slice_stats_print_json(FILE* out) prints the statistics of every slice type as a json array of objects.
+static inline void slice_stats_print_json(FILE* out){
+    slice_stats_type* type;
+    slice_stats stats;
+    int i;
+    fprintf(out,"[");
+    for(type = slice_atomic_load(&slice_stats_registry,acquire);type != NULL;type = type->next){
+        slice_stats_sum(type,&stats);
+        fprintf(out,"{\"name\":\"%s\",\"elem_size\":%zu",stats.name,stats.elem_size);
+        for(i = 0;i < SLICE_STATS_COUNT;i++){fprintf(out,",\"%s\":%zu",slice_stats_counter_name(i),stats.counters[i]);}
+        fprintf(out,"}%s",type->next != NULL ? "," : "");
+    }
+    fprintf(out,"]\n");
+}
+
+/*
+define_slice_stats(name,type) defines the statistics of the slice type $name,
+it is part of the definitions of every slice type that counts statistics.
+*/
+#define define_slice_stats(name,type) \
+static slice_stats_type ___slice_function_name___(stats_type,name);\
+static slice_thread_local slice_stats_local* ___slice_function_name___(stats_local_ptr,name);\
+static inline slice_stats_local* ___slice_function_name___(stats_local,name)(void){\
+    slice_stats_local* local = ___slice_function_name___(stats_local_ptr,name);\
+    if(local == NULL){\
+        local = slice_stats_attach(&___slice_function_name___(stats_type,name),#name,sizeof(type),&___slice_function_name___(stats_local_ptr,name));\
+        ___slice_function_name___(stats_local_ptr,name) = local;\
+    }\
+    return local;\
+}
+
+//slice_stats_add(name,counter,value) adds value to a counter of the slice type $name
+#define slice_stats_add(name,counter,value) slice_stats_bump(___slice_function_name___(stats_local,name)(),counter,value)
+//slice_stats_peak(name,cap) records a capacity of the slice type $name
+#define slice_stats_peak(name,cap) slice_stats_raise(___slice_function_name___(stats_local,name)(),SLICE_STATS_PEAK_CAP,cap)
+//slice_stats_realloc_decl declares the local slice_stats_realloc_begin stores into, it goes with the other declarations of a function
+#define slice_stats_realloc_decl uintptr_t ___slice_stats_old___;
+//slice_stats_realloc_begin(ptr) remembers where the storage of a slice was before a reallocation,
+//as an integer since the old pointer value is indeterminate once realloc freed it
+#define slice_stats_realloc_begin(ptr) ___slice_stats_old___ = (uintptr_t)(ptr);
+//slice_stats_realloc_end(name,ptr,old_cap,new_cap,elem_size) counts a reallocation that resized the storage from old_cap to new_cap elements
+#define slice_stats_realloc_end(name,ptr,old_cap,new_cap,elem_size) do{\
+    slice_stats_add(name,SLICE_STATS_REALLOCS,1);\
+    slice_stats_peak(name,new_cap);\
+    if((uintptr_t)(ptr) != ___slice_stats_old___){slice_stats_add(name,SLICE_STATS_BYTES_COPIED,((old_cap) < (new_cap) ? (old_cap) : (new_cap))*(elem_size));}\
+}while(0)
+#else
+#define define_slice_stats(name,type)
+#define slice_stats_add(name,counter,value) ((void)0)
+#define slice_stats_peak(name,cap) ((void)0)
+#define slice_stats_realloc_decl
+#define slice_stats_realloc_begin(ptr)
+#define slice_stats_realloc_end(name,ptr,old_cap,new_cap,elem_size) ((void)0)
+#endif
+
 /*
 define_slice_struct creates a struct to act as a slice type to hold objects of type $type,
 the slice has 3 attributes that should not be accessed directly unless you know what your doing,
@@ -236,6 +719,24 @@ and you know the pointer to the underlying container is valid
 #define slice_unsafe_value_len(slice_ptr) slice_ptr.SLICE_LENGTH_VARAIABLE_NAME
 #define slice_unsafe_value_cap(slice_ptr) slice_ptr.SLICE_CAPACITY_VARAIABLE_NAME
 
+/*
+deque slices also carry the offset of their first element in the underlying storage array.
+*/
+#define slice_unsafe_raw_head(slice_ptr) slice_ptr->SLICE_HEAD_VARAIABLE_NAME
+#define slice_unsafe_value_head(slice_ptr) slice_ptr.SLICE_HEAD_VARAIABLE_NAME
+
+/*
+small buffer slices also carry an inline storage array that is used before any storage is allocated.
+*/
+#define slice_unsafe_raw_inline(slice_ptr) slice_ptr->SLICE_INLINE_VARAIABLE_NAME
+#define slice_unsafe_value_inline(slice_ptr) slice_ptr.SLICE_INLINE_VARAIABLE_NAME
+
+/*
+allocator slices also carry a pointer to the slice_allocator their storage comes from.
+*/
+#define slice_unsafe_raw_allocator(slice_ptr) slice_ptr->SLICE_ALLOCATOR_VARAIABLE_NAME
+#define slice_unsafe_value_allocator(slice_ptr) slice_ptr.SLICE_ALLOCATOR_VARAIABLE_NAME
+
 
 
 
@@ -362,21 +863,55 @@ returns 1 on success and 0 on error
 */
 #define define_slice_resize_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size);SLICE_C_END
 
+/*
+int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+the array is grown at most once and the items are copied with a single memcpy,
+src must not point into the storage of the_thing.
+*/
+#define define_slice_append_n_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n); SLICE_C_END
+
+/*
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+returns 0 on failure and 1 on success, the array is grown at most once and the elements after index are shifted with a single memmove,
+src must not point into the storage of the_thing.
+*/
+#define define_slice_insert_n_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,size_t index,const type* src,size_t n); SLICE_C_END
+
+/*
+int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice (first <= last <= length),
+the elements after last are shifted with a single memmove, returns 0 on failure and 1 on success.
+*/
+#define define_slice_erase_range_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(erase_range,name)(name* the_thing,size_t first,size_t last); SLICE_C_END
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+the capacity is set to exactly new_cap if it has to grow, returns 0 on failure and 1 on success.
+*/
+#define define_slice_reserve_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap); SLICE_C_END
+
+/*
+int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+*/
+#define define_slice_grow_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed); SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+returns 0 on failure and 1 on success, the slice is left untouched on failure.
+*/
+#define define_slice_shrink_to_fit_decl(name,type) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing); SLICE_C_END
+
 /*
 int $name_append ($name* the_thing,type arg) appends an item to a slice, returns 0 on failure and 1 on success,
 this grows the array as nessecary and increases the length by 1 
 */
 #define define_slice_append(name,type) SLICE_C_BEGIN int ___slice_function_name___(append,name) (name* the_thing,type arg) {\
            if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_cap(the_thing) ==0){return 0;}   \
+           if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+               slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing)+1))){return 0;}\
+           slice_unsafe_raw_storage_ptr(the_thing)[slice_unsafe_raw_len(the_thing)] = arg;\
            slice_unsafe_raw_len(the_thing)++;\
-           if(slice_unsafe_raw_len(the_thing) == slice_unsafe_raw_cap(the_thing)) {\
-                slice_unsafe_raw_cap(the_thing)*=2; \
-                slice_unsafe_raw_storage_ptr(the_thing) = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_cap(the_thing));\
-           } else if(slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing) ){\
-               slice_unsafe_raw_cap(the_thing) = slice_unsafe_raw_len(the_thing) + slice_unsafe_raw_len(the_thing)/2 + 1;\
-               slice_unsafe_raw_storage_ptr(the_thing) = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_cap(the_thing));\
-           }                                     \
-           slice_unsafe_raw_storage_ptr(the_thing)[slice_unsafe_raw_len(the_thing)-1] = arg;\
+           slice_stats_add(name,SLICE_STATS_APPENDS,1);\
            return 1;\
 } SLICE_C_END
 
@@ -387,22 +922,13 @@ and therefore may be slow for large slices.
 */
 #define define_slice_front_append(name,type) SLICE_C_BEGIN int ___slice_function_name___(front_append,name) (name* the_thing,type arg) {\
         if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_cap(the_thing) ==0){return 0;}   \
-        slice_unsafe_raw_len(the_thing)++;\
-        if(slice_unsafe_raw_len(the_thing) == slice_unsafe_raw_cap(the_thing)) {\
-            slice_unsafe_raw_cap(the_thing)*=2; \
-            slice_unsafe_raw_storage_ptr(the_thing) = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_cap(the_thing));\
-        } else if(slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing) ){\
-            slice_unsafe_raw_cap(the_thing) = slice_unsafe_raw_len(the_thing) + slice_unsafe_raw_len(the_thing)/2 + 1;\
-            slice_unsafe_raw_storage_ptr(the_thing) = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_cap(the_thing));\
-        }\
-        if (slice_unsafe_raw_len(the_thing) >= 2) {\
-            \
-            for(size_t i= slice_unsafe_raw_len(the_thing)-2;i>0;i--){\
-                    slice_unsafe_raw_storage_ptr(the_thing)[i+1]= slice_unsafe_raw_storage_ptr(the_thing)[i];\
-            }\
-            slice_unsafe_raw_storage_ptr(the_thing)[1]= slice_unsafe_raw_storage_ptr(the_thing)[0];\
-        }                                  \
+        if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+            slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing)+1))){return 0;}\
+        slice_memmove(type,slice_unsafe_raw_storage_ptr(the_thing)+1,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+        slice_stats_add(name,SLICE_STATS_FRONT_SHIFTS,slice_unsafe_raw_len(the_thing));\
+        slice_stats_add(name,SLICE_STATS_APPENDS,1);\
         slice_unsafe_raw_storage_ptr(the_thing)[0] = arg;\
+        slice_unsafe_raw_len(the_thing)++;\
         return 1;\
 } SLICE_C_END
 
@@ -413,6 +939,8 @@ and MUST NOT be used after this function is called;
 #define define_slice_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name) (name* the_thing){\
     if(the_thing == NULL){return;}\
     if(slice_unsafe_raw_storage_ptr(the_thing) == NULL){slice_unsafe_raw_len(the_thing)=0;slice_unsafe_raw_cap(the_thing)=0;return;}\
+    slice_stats_add(name,SLICE_STATS_DESTROYS,1);\
+    if(slice_unsafe_raw_len(the_thing) < slice_unsafe_raw_cap(the_thing)){slice_stats_add(name,SLICE_STATS_WASTED_BYTES,(slice_unsafe_raw_cap(the_thing) - slice_unsafe_raw_len(the_thing))*sizeof(type));}\
     slice_free(slice_unsafe_raw_storage_ptr(the_thing));\
     slice_unsafe_raw_storage_ptr(the_thing)=NULL;\
     slice_unsafe_raw_cap(the_thing)=0;slice_unsafe_raw_len(the_thing)=0;\
@@ -487,6 +1015,7 @@ you dont know you may use the $name_bounded_at function
     if(result == NULL) {if(slice_unsafe_raw_len(the_thing)){slice_unsafe_raw_len(the_thing)--;}return 1;}\
     if(!slice_unsafe_raw_len(the_thing)){return 0;}\
     *result = slice_unsafe_raw_storage_ptr(the_thing)[0];\
+    slice_stats_add(name,SLICE_STATS_FRONT_SHIFTS,slice_unsafe_raw_len(the_thing)-1);\
     if (slice_unsafe_raw_len(the_thing)>1){\
         for(size_t i=1;i<slice_unsafe_raw_len(the_thing);i++){\
                 slice_unsafe_raw_storage_ptr(the_thing)[i-1]=slice_unsafe_raw_storage_ptr(the_thing)[i];\
@@ -509,6 +1038,8 @@ you dont know you may use the $name_bounded_at function
     if(slice_unsafe_value_cap(output) == 0){slice_unsafe_value_cap(output)+=10;}\
     if (slice_unsafe_value_len(output) > slice_unsafe_value_cap(output)){slice_unsafe_value_cap(output) = slice_unsafe_value_len(output) + 10;}\
     slice_unsafe_value_storage_ptr(output) =slice_calloc(type,slice_unsafe_value_cap(output));\
+    slice_stats_add(name,SLICE_STATS_MAKES,1);\
+    slice_stats_peak(name,slice_unsafe_value_cap(output));\
     return output;\
 } SLICE_C_END
 
@@ -548,20 +1079,215 @@ returns 1 on success and 0 on error
 */
 #define define_slice_resize(name,type)  SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size){\
     if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
-    if(new_size <= slice_unsafe_raw_len(the_thing)){\
-        slice_unsafe_raw_len(the_thing)=new_size;\
-        return 1;\
-    }\
-    if( new_size <= slice_unsafe_raw_cap(the_thing)) {\
-        slice_unsafe_raw_len(the_thing)=new_size;\
-        return 1;\
-    }\
-    slice_unsafe_raw_cap(the_thing) = new_size;\
-    slice_unsafe_raw_storage_ptr(the_thing) = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_cap(the_thing));\
+    if(new_size > slice_unsafe_raw_cap(the_thing) && slice_grow_failed(___slice_function_name___(grow,name)(the_thing,new_size))){return 0;}\
     slice_unsafe_raw_len(the_thing) = new_size;\
     return 1;\
 } SLICE_C_END
 
+/*
+int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+the array is grown at most once and the items are copied with a single memcpy,
+src must not point into the storage of the_thing.
+*/
+#define define_slice_append_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||(src == NULL && n != 0)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing) + slice_unsafe_raw_len(the_thing),src,n);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    slice_stats_add(name,SLICE_STATS_APPENDS,n);\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+returns 0 on failure and 1 on success, the array is grown at most once and the elements after index are shifted with a single memmove,
+src must not point into the storage of the_thing.
+*/
+#define define_slice_insert_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,size_t index,const type* src,size_t n){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||(src == NULL && n != 0)){return 0;}\
+    if(index > slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    slice_memmove(type,slice_unsafe_raw_storage_ptr(the_thing) + index + n,slice_unsafe_raw_storage_ptr(the_thing) + index,slice_unsafe_raw_len(the_thing) - index);\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing) + index,src,n);\
+    slice_stats_add(name,SLICE_STATS_FRONT_SHIFTS,slice_unsafe_raw_len(the_thing) - index);\
+    slice_stats_add(name,SLICE_STATS_APPENDS,n);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice (first <= last <= length),
+the elements after last are shifted with a single memmove, returns 0 on failure and 1 on success.
+*/
+#define define_slice_erase_range(name,type) SLICE_C_BEGIN int ___slice_function_name___(erase_range,name)(name* the_thing,size_t first,size_t last){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(first > last || last > slice_unsafe_raw_len(the_thing)){return 0;}\
+    slice_memmove(type,slice_unsafe_raw_storage_ptr(the_thing) + first,slice_unsafe_raw_storage_ptr(the_thing) + last,slice_unsafe_raw_len(the_thing) - last);\
+    slice_stats_add(name,SLICE_STATS_FRONT_SHIFTS,slice_unsafe_raw_len(the_thing) - last);\
+    slice_unsafe_raw_len(the_thing) -= last - first;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+the capacity is set to exactly new_cap if it has to grow, returns 0 on failure and 1 on success.
+*/
+#define define_slice_reserve(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    type* grown;\
+    slice_stats_realloc_decl\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(new_cap <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(new_cap > slice_max_cap(type)){return 0;}\
+    slice_stats_realloc_begin(slice_unsafe_raw_storage_ptr(the_thing))\
+    grown = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),new_cap);\
+    if(slice_alloc_failed(grown)){return 0;}\
+    slice_stats_realloc_end(name,grown,slice_unsafe_raw_cap(the_thing),new_cap,sizeof(type));\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+*/
+#define define_slice_grow(name,type) SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed){\
+    size_t new_cap;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(needed <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    new_cap = SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),needed,sizeof(type));\
+    if(new_cap < needed){new_cap = needed;}\
+    return ___slice_function_name___(reserve,name)(the_thing,new_cap);\
+} SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+returns 0 on failure and 1 on success, the slice is left untouched on failure.
+*/
+#define define_slice_shrink_to_fit(name,type) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing){\
+    type* shrunk;\
+    size_t new_cap;\
+    slice_stats_realloc_decl\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    new_cap = slice_unsafe_raw_len(the_thing) ? slice_unsafe_raw_len(the_thing) : 1;\
+    if(new_cap >= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    slice_stats_realloc_begin(slice_unsafe_raw_storage_ptr(the_thing))\
+    shrunk = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),new_cap);\
+    if(slice_alloc_failed(shrunk)){return 0;}\
+    slice_stats_realloc_end(name,shrunk,slice_unsafe_raw_cap(the_thing),new_cap,sizeof(type));\
+    slice_unsafe_raw_storage_ptr(the_thing) = shrunk;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+Views.
+A view ($name_view) is a pointer and a length that refers to elements owned by something else (a slice, a mapping,
+a buffer), it never allocates or frees anything so making one costs nothing.
+A view of a slice is invalidated by anything that grows, shrinks or destroys the slice.
+define_slice_view_struct creates the view struct of a slice, the name of the struct will be $name_view
+*/
+#define define_slice_view_struct(name,type) SLICE_C_BEGIN typedef struct ___slice_function_name___(view,name) { type* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;} ___slice_function_name___(view,name); SLICE_C_END
+
+/*
+define_slice_view_decl(name,type) creates the view struct and the declarations of the view functions.
+*/
+#define define_slice_view_decl(name,type) define_slice_view_struct(name,type);\
+SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(view_make,name)(type* data,size_t len); SLICE_C_END;\
+SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(as_view,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(subslice,name)(name* the_thing,size_t from,size_t to); SLICE_C_END;\
+SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(view_subslice,name)(___slice_function_name___(view,name) view,size_t from,size_t to); SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(view_at,name)(___slice_function_name___(view,name) view,size_t index); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_bounded_at,name)(___slice_function_name___(view,name) view,size_t index,type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_equal,name)(___slice_function_name___(view,name) a,___slice_function_name___(view,name) b); SLICE_C_END
+
+/*
+$name_view $name_view_make(type* data,size_t len) makes a view of len elements starting at data.
+*/
+#define define_slice_view_make(name,type) SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(view_make,name)(type* data,size_t len){\
+    ___slice_function_name___(view,name) output;\
+    slice_unsafe_value_storage_ptr(output) = data;\
+    slice_unsafe_value_len(output) = data == NULL ? 0 : len;\
+    return output;\
+} SLICE_C_END
+
+/*
+$name_view $name_as_view($name* the_thing) makes a view of every element of a slice.
+*/
+#define define_slice_as_view(name,type) SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(as_view,name)(name* the_thing){\
+    if(the_thing == NULL){return ___slice_function_name___(view_make,name)(NULL,0);}\
+    return ___slice_function_name___(view_make,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+} SLICE_C_END
+
+/*
+$name_view $name_view_subslice($name_view view,size_t from,size_t to) makes a view of the elements [from,to) of a view,
+the view is empty (NULL data) if from > to or to > the length of the view.
+*/
+#define define_slice_view_subslice(name,type) SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(view_subslice,name)(___slice_function_name___(view,name) view,size_t from,size_t to){\
+    if(from > to||to > slice_unsafe_value_len(view)){return ___slice_function_name___(view_make,name)(NULL,0);}\
+    return ___slice_function_name___(view_make,name)(slice_unsafe_value_storage_ptr(view) + from,to - from);\
+} SLICE_C_END
+
+/*
+$name_view $name_subslice($name* the_thing,size_t from,size_t to) makes a view of the elements [from,to) of a slice without copying them,
+the view is empty (NULL data) if from > to or to > the length of the slice.
+*/
+#define define_slice_subslice(name,type) SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(subslice,name)(name* the_thing,size_t from,size_t to){\
+    return ___slice_function_name___(view_subslice,name)(___slice_function_name___(as_view,name)(the_thing),from,to);\
+} SLICE_C_END
+
+/*
+$type $name_view_at($name_view view,size_t index) returns the value at an index of a view,
+this function should only be called if you know index < the view length, if
+you dont know you may use the $name_view_bounded_at function
+*/
+#define define_slice_view_at(name,type) SLICE_C_BEGIN type ___slice_function_name___(view_at,name)(___slice_function_name___(view,name) view,size_t index){\
+    return slice_unsafe_value_storage_ptr(view)[index];\
+} SLICE_C_END
+
+/*
+int $name_view_bounded_at($name_view view,size_t index,type* result) gets the value of a view at index 'index' and fills the value into result,
+returns 1 on success and 0 on error.
+*/
+#define define_slice_view_bounded_at(name,type) SLICE_C_BEGIN int ___slice_function_name___(view_bounded_at,name)(___slice_function_name___(view,name) view,size_t index,type* result){\
+    if(result == NULL||index >= slice_unsafe_value_len(view)){return 0;}\
+    *result = slice_unsafe_value_storage_ptr(view)[index];\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_view_equal($name_view a,$name_view b) returns 1 if both views have the same length and the same bytes, 0 otherwise
+(compare with LESS through define_slice_sorted for types with padding or several representations of a value).
+*/
+#define define_slice_view_equal(name,type) SLICE_C_BEGIN int ___slice_function_name___(view_equal,name)(___slice_function_name___(view,name) a,___slice_function_name___(view,name) b){\
+    if(slice_unsafe_value_len(a) != slice_unsafe_value_len(b)){return 0;}\
+    if(slice_unsafe_value_len(a) == 0||slice_unsafe_value_storage_ptr(a) == slice_unsafe_value_storage_ptr(b)){return 1;}\
+    return SLICE_UNSAFE_MEMCMP(slice_unsafe_value_storage_ptr(a),slice_unsafe_value_storage_ptr(b),slice_unsafe_value_len(a)*sizeof(type)) == 0;\
+} SLICE_C_END
+
+/*
+define_slice_view_definitions(name,type) creates the definitions of the view functions.
+*/
+#define define_slice_view_definitions(name,type) define_slice_as_view(name,type);\
+define_slice_view_common_definitions(name,type)
+
+/*
+define_slice_view_common_definitions(name,type) creates the definitions of the view functions except $name_as_view,
+for slice types that store their elements differently.
+*/
+#define define_slice_view_common_definitions(name,type) define_slice_view_make(name,type);\
+define_slice_view_subslice(name,type);\
+define_slice_subslice(name,type);\
+define_slice_view_at(name,type);\
+define_slice_view_bounded_at(name,type);\
+define_slice_view_equal(name,type)
+
 
 
 
@@ -631,6 +1357,30 @@ int $name_cap(name the_thing);
 //int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of the slice,
 //returns 1 on success and 0 on error 
 int $name_resize($name* slice,size_t new_len);
+
+//int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+//the array is grown at most once and the items are copied with a single memcpy, src must not point into the slice.
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+
+//int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+//returns 0 on failure and 1 on success, the array is grown at most once, src must not point into the slice.
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n);
+
+//int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice,
+//returns 0 on failure and 1 on success.
+int $name_erase_range ($name* the_thing,size_t first,size_t last);
+
+//int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+//returns 0 on failure and 1 on success.
+int $name_reserve ($name* the_thing,size_t new_cap);
+
+//int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+//the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+int $name_grow ($name* the_thing,size_t needed);
+
+//int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+//returns 0 on failure and 1 on success.
+int $name_shrink_to_fit ($name* the_thing);
 */
 #define define_slice_all_funct_decl(name,type) define_slice_make_raw_decl(name,type);\
 define_slice_make_decl(name,type);\
@@ -646,7 +1396,13 @@ define_slice_ok_decl(name,type);\
 define_slice_length_decl(name);\
 define_slice_front_append_decl(name,type);\
 define_slice_cap_decl(name);\
-define_slice_resize_decl(name,type)
+define_slice_resize_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+define_slice_insert_n_decl(name,type);\
+define_slice_erase_range_decl(name,type);\
+define_slice_reserve_decl(name,type);\
+define_slice_grow_decl(name,type);\
+define_slice_shrink_to_fit_decl(name,type)
 
 
 /*
@@ -728,8 +1484,49 @@ int $name_cap(name the_thing);
 //int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of the slice,
 //returns 1 on success and 0 on error 
 int $name_resize($name* slice,size_t new_len);
+
+//int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+//the array is grown at most once and the items are copied with a single memcpy, src must not point into the slice.
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+
+//int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+//returns 0 on failure and 1 on success, the array is grown at most once, src must not point into the slice.
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n);
+
+//int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice,
+//returns 0 on failure and 1 on success.
+int $name_erase_range ($name* the_thing,size_t first,size_t last);
+
+//int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+//returns 0 on failure and 1 on success.
+int $name_reserve ($name* the_thing,size_t new_cap);
+
+//int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+//the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+int $name_grow ($name* the_thing,size_t needed);
+
+//int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+//returns 0 on failure and 1 on success.
+int $name_shrink_to_fit ($name* the_thing);
+
+//$name_view is a non-owning view {type* data;size_t len;} of elements owned by something else,
+//it is invalidated by anything that grows, shrinks or destroys the slice it views.
+//$name_view $name_as_view($name* the_thing) views the whole slice, $name_view $name_subslice($name* the_thing,size_t from,size_t to)
+//views the elements [from,to) without copying them (empty view with NULL data if the range is invalid).
+$name_view $name_as_view($name* the_thing);
+$name_view $name_subslice($name* the_thing,size_t from,size_t to);
+
+//$name_view $name_view_make(type* data,size_t len) views len elements starting at data,
+//$name_view_subslice, $name_view_at and $name_view_bounded_at work like $name_subslice, $name_at and $name_bounded_at on a view.
+$name_view $name_view_make(type* data,size_t len);
+$name_view $name_view_subslice($name_view view,size_t from,size_t to);
+$type $name_view_at($name_view view,size_t index);
+int $name_view_bounded_at($name_view view,size_t index,type* result);
+
+//int $name_view_equal($name_view a,$name_view b) returns 1 if both views have the same length and bytes, 0 otherwise.
+int $name_view_equal($name_view a,$name_view b);
 */
-#define define_slice_declarations(name,type)define_slice_struct(name,type);define_slice_all_funct_decl(name,type)
+#define define_slice_declarations(name,type)define_slice_struct(name,type);define_slice_all_funct_decl(name,type);define_slice_view_decl(name,type)
 
 #define slice_clear(slice_ptr) slice_ptr->len = 0;
 /*
@@ -799,8 +1596,50 @@ int $name_cap(name the_thing);
 //int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of the slice,
 //returns 1 on success and 0 on error 
 int $name_resize($name* slice,size_t new_len);
+
+//int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+//the array is grown at most once and the items are copied with a single memcpy, src must not point into the slice.
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+
+//int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+//returns 0 on failure and 1 on success, the array is grown at most once, src must not point into the slice.
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n);
+
+//int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice,
+//returns 0 on failure and 1 on success.
+int $name_erase_range ($name* the_thing,size_t first,size_t last);
+
+//int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+//returns 0 on failure and 1 on success.
+int $name_reserve ($name* the_thing,size_t new_cap);
+
+//int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+//the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+int $name_grow ($name* the_thing,size_t needed);
+
+//int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+//returns 0 on failure and 1 on success.
+int $name_shrink_to_fit ($name* the_thing);
+
+//$name_view is a non-owning view {type* data;size_t len;} of elements owned by something else,
+//it is invalidated by anything that grows, shrinks or destroys the slice it views.
+//$name_view $name_as_view($name* the_thing) views the whole slice, $name_view $name_subslice($name* the_thing,size_t from,size_t to)
+//views the elements [from,to) without copying them (empty view with NULL data if the range is invalid).
+$name_view $name_as_view($name* the_thing);
+$name_view $name_subslice($name* the_thing,size_t from,size_t to);
+
+//$name_view $name_view_make(type* data,size_t len) views len elements starting at data,
+//$name_view_subslice, $name_view_at and $name_view_bounded_at work like $name_subslice, $name_at and $name_bounded_at on a view.
+$name_view $name_view_make(type* data,size_t len);
+$name_view $name_view_subslice($name_view view,size_t from,size_t to);
+$type $name_view_at($name_view view,size_t index);
+int $name_view_bounded_at($name_view view,size_t index,type* result);
+
+//int $name_view_equal($name_view a,$name_view b) returns 1 if both views have the same length and bytes, 0 otherwise.
+int $name_view_equal($name_view a,$name_view b);
 */
-#define define_slice_definitions(name,type) define_slice_make_raw(name,type);\
+#define define_slice_definitions(name,type) define_slice_stats(name,type)\
+define_slice_make_raw(name,type);\
 define_slice_make(name,type);\
 define_slice_destroy(name,type);\
 define_slice_append(name,type);\
@@ -814,7 +1653,14 @@ define_slice_front_pop(name,type);\
 define_slice_ok(name,type);\
 define_slice_length(name);\
 define_slice_cap(name);\
-define_slice_resize(name,type);
+define_slice_resize(name,type);\
+define_slice_append_n(name,type);\
+define_slice_insert_n(name,type);\
+define_slice_erase_range(name,type);\
+define_slice_reserve(name,type);\
+define_slice_grow(name,type);\
+define_slice_shrink_to_fit(name,type);\
+define_slice_view_definitions(name,type);
 
 
 
@@ -898,10 +1744,1565 @@ int $name_cap(name the_thing);
 //int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of the slice,
 //returns 1 on success and 0 on error 
 int $name_resize($name* slice,size_t new_len);
+
+//int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a slice, returns 0 on failure and 1 on success,
+//the array is grown at most once and the items are copied with a single memcpy, src must not point into the slice.
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+
+//int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length),
+//returns 0 on failure and 1 on success, the array is grown at most once, src must not point into the slice.
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n);
+
+//int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a slice,
+//returns 0 on failure and 1 on success.
+int $name_erase_range ($name* the_thing,size_t first,size_t last);
+
+//int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a slice is at least new_cap,
+//returns 0 on failure and 1 on success.
+int $name_reserve ($name* the_thing,size_t new_cap);
+
+//int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a slice is at least needed,
+//the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+int $name_grow ($name* the_thing,size_t needed);
+
+//int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a slice to its length (at least 1),
+//returns 0 on failure and 1 on success.
+int $name_shrink_to_fit ($name* the_thing);
+
+//$name_view is a non-owning view {type* data;size_t len;} of elements owned by something else,
+//it is invalidated by anything that grows, shrinks or destroys the slice it views.
+//$name_view $name_as_view($name* the_thing) views the whole slice, $name_view $name_subslice($name* the_thing,size_t from,size_t to)
+//views the elements [from,to) without copying them (empty view with NULL data if the range is invalid).
+$name_view $name_as_view($name* the_thing);
+$name_view $name_subslice($name* the_thing,size_t from,size_t to);
+
+//$name_view $name_view_make(type* data,size_t len) views len elements starting at data,
+//$name_view_subslice, $name_view_at and $name_view_bounded_at work like $name_subslice, $name_at and $name_bounded_at on a view.
+$name_view $name_view_make(type* data,size_t len);
+$name_view $name_view_subslice($name_view view,size_t from,size_t to);
+$type $name_view_at($name_view view,size_t index);
+int $name_view_bounded_at($name_view view,size_t index,type* result);
+
+//int $name_view_equal($name_view a,$name_view b) returns 1 if both views have the same length and bytes, 0 otherwise.
+int $name_view_equal($name_view a,$name_view b);
 */
 #define define_slice(name,type) define_slice_declarations(name,type);define_slice_definitions(name,type)
 
 
 
 
+/*
+Deque slices.
+A deque slice is a ring buffer that stores its elements starting at an offset (head) into the underlying
+storage array and wraps around at the capacity, so adding or removing elements at either end never shifts the
+other elements; front operations are O(1) amortized instead of O(n).
+A deque slice provides the same functions as a regular slice ($name_append,$name_front_append,$name_pop,...)
+so you may swap a slice for a deque slice by only changing the type name,
+note that the underlying storage array of a deque slice is NOT contiguous in index order,
+so slice_unsafe_get/slice_unsafe_set must not be used on them, use slice_unsafe_deque_get instead.
+*/
+
+/*
+define_slice_deque_struct creates a struct to act as a deque slice type to hold objects of type $type,
+the slice has 4 attributes that should not be accessed directly unless you know what your doing,
+instead accessor functions are defined in this header that allow you to modify the slice
+*/
+#define define_slice_deque_struct(name,type) SLICE_C_BEGIN typedef struct name { type* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;size_t SLICE_HEAD_VARAIABLE_NAME;} name; SLICE_C_END
+
+/*
+this macro maps an index of a deque slice to the index in its underlying storage array.
+the parameter supplied must be a NON-NULL pointer to a deque slice object with a capacity > 0 and index < capacity.
+*/
+#define slice_unsafe_deque_index(slice_ptr,index) \
+    (slice_unsafe_raw_head(slice_ptr) + (index) >= slice_unsafe_raw_cap(slice_ptr) ? \
+        slice_unsafe_raw_head(slice_ptr) + (index) - slice_unsafe_raw_cap(slice_ptr) : slice_unsafe_raw_head(slice_ptr) + (index))
+
+/*
+this macro provides access to get a value at an index in a deque slice.
+the parameter supplied must be a NON-NULL pointer to a deque slice object.
+you should only use this function if you are not changing the pointer to the underlying container,
+and you know the pointer to the underlying container is valid
+*/
+#define slice_unsafe_deque_get(slice_ptr,index) slice_unsafe_raw_storage_ptr(slice_ptr)[slice_unsafe_deque_index(slice_ptr,index)]
+
+/*
+$name $name_make_raw (size_t cap,size_t len) creates a deque slice with the given capacity and length,
+you are encouraged to not call this function and call $name_make instead
+unless you know what your doing, when done with the slice you MUST call
+$name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_deque_make_raw(name,type) SLICE_C_BEGIN name ___slice_function_name___(make_raw,name)(size_t cap,size_t len){\
+    name output = {NULL,len,cap,0};\
+    if(slice_unsafe_value_cap(output) == 0){slice_unsafe_value_cap(output)+=10;}\
+    if (slice_unsafe_value_len(output) > slice_unsafe_value_cap(output)){slice_unsafe_value_cap(output) = slice_unsafe_value_len(output) + 10;}\
+    slice_unsafe_value_storage_ptr(output) =slice_calloc(type,slice_unsafe_value_cap(output));\
+    return output;\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys a deque slice, this MUST be called when the slice is done being used,
+and MUST NOT be used after this function is called;
+*/
+#define define_slice_deque_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name) (name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_free(slice_unsafe_raw_storage_ptr(the_thing));}\
+    slice_unsafe_raw_storage_ptr(the_thing)=NULL;\
+    slice_unsafe_raw_cap(the_thing)=0;slice_unsafe_raw_len(the_thing)=0;slice_unsafe_raw_head(the_thing)=0;\
+    return;\
+} SLICE_C_END
+
+/*
+int $name_reserve($name* the_thing,size_t new_cap) grows the capacity of a deque slice to at least new_cap,
+the elements keep their order, returns 1 on success and 0 on error (the slice is left untouched on error).
+*/
+#define define_slice_deque_reserve(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    type* grown;\
+    size_t old_cap,wrapped;\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
+    old_cap = slice_unsafe_raw_cap(the_thing);\
+    if(new_cap <= old_cap){return 1;}\
+    if(new_cap > slice_max_cap(type)){return 0;}\
+    grown = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),new_cap);\
+    if(slice_alloc_failed(grown)){return 0;}\
+    if(slice_unsafe_raw_head(the_thing) + slice_unsafe_raw_len(the_thing) > old_cap){\
+        wrapped = old_cap - slice_unsafe_raw_head(the_thing);\
+        slice_memmove(type,grown + new_cap - wrapped,grown + slice_unsafe_raw_head(the_thing),wrapped);\
+        slice_unsafe_raw_head(the_thing) = new_cap - wrapped;\
+    }\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_push_back ($name* the_thing,type arg) appends an item to the back of a deque slice, returns 0 on failure and 1 on success,
+this grows the array as nessecary and increases the length by 1
+*/
+#define define_slice_deque_push_back(name,type) SLICE_C_BEGIN int ___slice_function_name___(push_back,name) (name* the_thing,type arg) {\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_cap(the_thing) ==0){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),slice_unsafe_raw_len(the_thing)+1,sizeof(type))))){return 0;}\
+    slice_unsafe_deque_get(the_thing,slice_unsafe_raw_len(the_thing)) = arg;\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_push_front ($name* the_thing,type arg) appends an item to the front of a deque slice, returns 0 on failure and 1 on success,
+this grows the array as nessecary and increases the length by 1, no other element is moved.
+*/
+#define define_slice_deque_push_front(name,type) SLICE_C_BEGIN int ___slice_function_name___(push_front,name) (name* the_thing,type arg) {\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_cap(the_thing) ==0){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),slice_unsafe_raw_len(the_thing)+1,sizeof(type))))){return 0;}\
+    slice_unsafe_raw_head(the_thing) = slice_unsafe_raw_head(the_thing) == 0 ? slice_unsafe_raw_cap(the_thing)-1 : slice_unsafe_raw_head(the_thing)-1;\
+    slice_unsafe_raw_storage_ptr(the_thing)[slice_unsafe_raw_head(the_thing)] = arg;\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_pop_back ($name* the_thing,type* result) puts the last element of the deque slice into result(if not null and len >0) and, shrinks the slice by 1;
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_deque_pop_back(name,type) SLICE_C_BEGIN int ___slice_function_name___(pop_back,name)(name* the_thing,type* result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
+    if(slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)){slice_unsafe_raw_len(the_thing) = slice_unsafe_raw_cap(the_thing);}\
+    if(result == NULL) {if(slice_unsafe_raw_len(the_thing)){slice_unsafe_raw_len(the_thing)--;}return 1;}\
+    if(!slice_unsafe_raw_len(the_thing)){return 0;}\
+    *result = slice_unsafe_deque_get(the_thing,slice_unsafe_raw_len(the_thing)-1);\
+    slice_unsafe_raw_len(the_thing)--;\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_pop_front ($name* the_thing,type* result) puts the first element of the deque slice into result(if not null and len >0) and, shrinks the slice by 1;
+ no other element is moved.
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_deque_pop_front(name,type) SLICE_C_BEGIN int ___slice_function_name___(pop_front,name)(name* the_thing,type* result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
+    if(slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)){slice_unsafe_raw_len(the_thing) = slice_unsafe_raw_cap(the_thing);}\
+    if(!slice_unsafe_raw_len(the_thing)){return result == NULL;}\
+    if(result != NULL){*result = slice_unsafe_raw_storage_ptr(the_thing)[slice_unsafe_raw_head(the_thing)];}\
+    slice_unsafe_raw_head(the_thing)++;\
+    if(slice_unsafe_raw_head(the_thing) == slice_unsafe_raw_cap(the_thing)){slice_unsafe_raw_head(the_thing) = 0;}\
+    slice_unsafe_raw_len(the_thing)--;\
+    return 1;\
+} SLICE_C_END
+
+/*
+$type $name_at(name* the_thing,size_t index) returns the value at an index of a deque slice,
+this function should only be called if you know index < the slice length, if
+you dont know you may use the $name_bounded_at function
+*/
+#define define_slice_deque_at(name,type)  SLICE_C_BEGIN type ___slice_function_name___(at,name)(name* the_thing,size_t index){\
+    return slice_unsafe_deque_get(the_thing,index);\
+} SLICE_C_END
+
+/*
+void $name_set(name* the_thing,size_t index,$type result) sets the value at an index of a deque slice,
+this function should only be called if you know index < the slice length, if
+you dont know you may use the $name_bounded_set function
+*/
+#define define_slice_deque_set(name,type)  SLICE_C_BEGIN void ___slice_function_name___(set,name)(name* the_thing,size_t index,type result){\
+    slice_unsafe_deque_get(the_thing,index) = result;\
+    return;\
+} SLICE_C_END
+
+/*
+ int $name_bounded_at ($name* the_thing,size_t index,type* result) gets the value of a deque slice at index 'index' and fills the value into result,
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_deque_bounded_at(name,type) SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,type* result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL || result == NULL || slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)) {return 0;}\
+    if(index >= slice_unsafe_raw_len(the_thing)) {return 0;}\
+    *result = slice_unsafe_deque_get(the_thing,index);\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_bounded_set ($name* the_thing,size_t index,type result) sets the value of a deque slice at index 'index' to result,
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_deque_bounded_set(name,type) SLICE_C_BEGIN int ___slice_function_name___(bounded_set,name)(name* the_thing,size_t index,type result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL || slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)) {return 0;}\
+    if(index >= slice_unsafe_raw_len(the_thing)) {return 0;}\
+    slice_unsafe_deque_get(the_thing,index) = result;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of a deque slice,
+new elements are added at the back and the capacity grows by SLICE_GROWTH_POLICY like $name_grow, returns 1 on success and 0 on error
+*/
+#define define_slice_deque_resize(name,type)  SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
+    if(new_size > slice_unsafe_raw_cap(the_thing) && slice_grow_failed(___slice_function_name___(grow,name)(the_thing,new_size))){return 0;}\
+    slice_unsafe_raw_len(the_thing) = new_size;\
+    return 1;\
+} SLICE_C_END
+
+/*
+void $name_make_contiguous($name* the_thing) rotates the storage array of a deque slice so its elements are stored
+in index order starting at the beginning of the array (head becomes 0), nothing is allocated,
+it costs O(cap) when the elements wrap around the end of the array and nothing otherwise.
+*/
+#define define_slice_deque_make_contiguous(name,type) SLICE_C_BEGIN void ___slice_function_name___(make_contiguous,name)(name* the_thing){\
+    type* data;\
+    type tmp;\
+    size_t ranges[3][2],r,lo,hi;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_head(the_thing) == 0){return;}\
+    data = slice_unsafe_raw_storage_ptr(the_thing);\
+    if(slice_unsafe_raw_head(the_thing) + slice_unsafe_raw_len(the_thing) <= slice_unsafe_raw_cap(the_thing)){\
+        slice_memmove(type,data,data + slice_unsafe_raw_head(the_thing),slice_unsafe_raw_len(the_thing));\
+        slice_unsafe_raw_head(the_thing) = 0;\
+        return;\
+    }\
+    ranges[0][0] = 0;ranges[0][1] = slice_unsafe_raw_head(the_thing);\
+    ranges[1][0] = slice_unsafe_raw_head(the_thing);ranges[1][1] = slice_unsafe_raw_cap(the_thing);\
+    ranges[2][0] = 0;ranges[2][1] = slice_unsafe_raw_cap(the_thing);\
+    for(r = 0;r < 3;r++){\
+        for(lo = ranges[r][0],hi = ranges[r][1];lo + 1 < hi;lo++,hi--){\
+            tmp = data[lo];\
+            data[lo] = data[hi - 1];\
+            data[hi - 1] = tmp;\
+        }\
+    }\
+    slice_unsafe_raw_head(the_thing) = 0;\
+} SLICE_C_END
+
+/*
+int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a deque slice is at least needed,
+the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+*/
+#define define_slice_deque_grow(name,type) SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed){\
+    size_t new_cap;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(needed <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    new_cap = SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),needed,sizeof(type));\
+    if(new_cap < needed){new_cap = needed;}\
+    return ___slice_function_name___(reserve,name)(the_thing,new_cap);\
+} SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) makes a deque slice contiguous and shrinks its capacity to its length (at least 1),
+returns 0 on failure and 1 on success, the elements keep their order on failure.
+*/
+#define define_slice_deque_shrink_to_fit(name,type) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing){\
+    type* shrunk;\
+    size_t new_cap;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    new_cap = slice_unsafe_raw_len(the_thing) ? slice_unsafe_raw_len(the_thing) : 1;\
+    if(new_cap >= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    ___slice_function_name___(make_contiguous,name)(the_thing);\
+    shrunk = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),new_cap);\
+    if(slice_alloc_failed(shrunk)){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing) = shrunk;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to the back of a deque slice,
+returns 0 on failure and 1 on success, the array is grown at most once and the items are copied with at most two memcpy,
+src must not point into the storage of the_thing.
+*/
+#define define_slice_deque_append_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n){\
+    size_t tail,first;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||(src == NULL && n != 0)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    tail = slice_unsafe_deque_index(the_thing,slice_unsafe_raw_len(the_thing));\
+    first = slice_unsafe_raw_cap(the_thing) - tail < n ? slice_unsafe_raw_cap(the_thing) - tail : n;\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing) + tail,src,first);\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing),src + first,n - first);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length)
+of a deque slice, returns 0 on failure and 1 on success, the array is grown at most once, made contiguous and the elements
+after index are shifted with a single memmove, src must not point into the storage of the_thing.
+*/
+#define define_slice_deque_insert_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,size_t index,const type* src,size_t n){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||(src == NULL && n != 0)){return 0;}\
+    if(index > slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(index == slice_unsafe_raw_len(the_thing)){return ___slice_function_name___(append_n,name)(the_thing,src,n);}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    ___slice_function_name___(make_contiguous,name)(the_thing);\
+    slice_memmove(type,slice_unsafe_raw_storage_ptr(the_thing) + index + n,slice_unsafe_raw_storage_ptr(the_thing) + index,slice_unsafe_raw_len(the_thing) - index);\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing) + index,src,n);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a deque slice (first <= last <= length),
+removing from the front only moves the head, otherwise the slice is made contiguous and the elements after last are shifted
+with a single memmove, returns 0 on failure and 1 on success.
+*/
+#define define_slice_deque_erase_range(name,type) SLICE_C_BEGIN int ___slice_function_name___(erase_range,name)(name* the_thing,size_t first,size_t last){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(first > last || last > slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(first == last){return 1;}\
+    if(first == 0){\
+        slice_unsafe_raw_head(the_thing) = last == slice_unsafe_raw_len(the_thing) ? 0 : slice_unsafe_deque_index(the_thing,last);\
+        slice_unsafe_raw_len(the_thing) -= last;\
+        return 1;\
+    }\
+    if(last < slice_unsafe_raw_len(the_thing)){\
+        ___slice_function_name___(make_contiguous,name)(the_thing);\
+        slice_memmove(type,slice_unsafe_raw_storage_ptr(the_thing) + first,slice_unsafe_raw_storage_ptr(the_thing) + last,slice_unsafe_raw_len(the_thing) - last);\
+    }\
+    slice_unsafe_raw_len(the_thing) -= last - first;\
+    return 1;\
+} SLICE_C_END
+
+/*
+$name_view $name_as_view($name* the_thing) makes a view of every element of a deque slice,
+the slice is made contiguous first ($name_make_contiguous) so the view is a plain pointer and length,
+$name_subslice goes through this function too.
+*/
+#define define_slice_deque_as_view(name,type) SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(as_view,name)(name* the_thing){\
+    if(the_thing == NULL){return ___slice_function_name___(view_make,name)(NULL,0);}\
+    ___slice_function_name___(make_contiguous,name)(the_thing);\
+    return ___slice_function_name___(view_make,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+} SLICE_C_END
+
+/*
+the regular slice names of the deque functions, so that a deque slice may replace a slice
+without changing the call sites.
+*/
+#define define_slice_deque_aliases(name,type) SLICE_C_BEGIN \
+    name ___slice_function_name___(make,name)(size_t cap){return ___slice_function_name___(make_raw,name)(cap,0);}\
+    int ___slice_function_name___(append,name)(name* the_thing,type arg){return ___slice_function_name___(push_back,name)(the_thing,arg);}\
+    int ___slice_function_name___(front_append,name)(name* the_thing,type arg){return ___slice_function_name___(push_front,name)(the_thing,arg);}\
+    int ___slice_function_name___(pop,name)(name* the_thing,type* result){return ___slice_function_name___(pop_back,name)(the_thing,result);}\
+    int ___slice_function_name___(front_pop,name)(name* the_thing,type* result){return ___slice_function_name___(pop_front,name)(the_thing,result);}\
+SLICE_C_END
+
+/*
+define_slice_deque_all_funct_decl(name,type) creates all the function declarations needed to create a deque slice.
+*/
+#define define_slice_deque_all_funct_decl(name,type) define_slice_make_raw_decl(name,type);\
+define_slice_make_decl(name,type);\
+define_slice_destroy_decl(name,type);\
+SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(push_back,name)(name* the_thing,type arg); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(push_front,name)(name* the_thing,type arg); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(pop_back,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(pop_front,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(make_contiguous,name)(name* the_thing); SLICE_C_END;\
+define_slice_grow_decl(name,type);\
+define_slice_shrink_to_fit_decl(name,type);\
+define_slice_append_decl(name,type);\
+define_slice_front_append_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+define_slice_insert_n_decl(name,type);\
+define_slice_erase_range_decl(name,type);\
+define_slice_at_decl(name,type);\
+define_slice_set_decl(name,type);\
+define_slice_bounded_at_decl(name,type);\
+define_slice_bounded_set_decl(name,type);\
+define_slice_pop_decl(name,type);\
+define_slice_front_pop_decl(name,type);\
+define_slice_ok_decl(name,type);\
+define_slice_length_decl(name);\
+define_slice_cap_decl(name);\
+define_slice_resize_decl(name,type)
+
+/*
+define_slice_deque_declarations(name,type) creates a deque slice named $name to act as a double ended queue for $type.
+It will create a struct declaration and all function declarations to
+provide a means to utilize the struct
+The created struct will have declaration
+typedef struct $name {
+    $type* data;
+    size_t len;
+    size_t cap;
+    size_t head;
+} $name;
+*/
+#define define_slice_deque_declarations(name,type) define_slice_deque_struct(name,type);define_slice_deque_all_funct_decl(name,type);define_slice_view_decl(name,type)
+
+/*
+define_slice_deque_definitions(name,type) creates all the function definitions to use a deque slice.
+define_slice_deque_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_deque_struct).
+*/
+#define define_slice_deque_definitions(name,type) define_slice_deque_make_raw(name,type);\
+define_slice_deque_destroy(name,type);\
+define_slice_deque_reserve(name,type);\
+define_slice_deque_push_back(name,type);\
+define_slice_deque_push_front(name,type);\
+define_slice_deque_pop_back(name,type);\
+define_slice_deque_pop_front(name,type);\
+define_slice_deque_make_contiguous(name,type);\
+define_slice_deque_grow(name,type);\
+define_slice_deque_shrink_to_fit(name,type);\
+define_slice_deque_append_n(name,type);\
+define_slice_deque_insert_n(name,type);\
+define_slice_deque_erase_range(name,type);\
+define_slice_deque_aliases(name,type);\
+define_slice_deque_at(name,type);\
+define_slice_deque_set(name,type);\
+define_slice_deque_bounded_at(name,type);\
+define_slice_deque_bounded_set(name,type);\
+define_slice_ok(name,type);\
+define_slice_length(name);\
+define_slice_cap(name);\
+define_slice_deque_resize(name,type);\
+define_slice_deque_as_view(name,type);\
+define_slice_view_common_definitions(name,type);
+
+/*
+define_slice_deque(name,type) creates a deque slice named $name to act as a double ended queue for $type.
+It will create a struct declaration and function declarations to
+provide a means to utilize the struct.
+It will also define all the functions,
+so if you wish to seperate the functions from
+the declearations you may use
+define_slice_deque_declarations(name,type) and define_slice_deque_definitions(name,type).
+It will create every function a slice created by define_slice(name,type) has, plus the following functions:
+
+//int $name_push_back ($name* the_thing,type arg) appends an item to the back of the deque slice (same as $name_append),
+//returns 0 on failure and 1 on success.
+int $name_push_back ($name* the_thing,type arg);
+
+//int $name_push_front ($name* the_thing,type arg) appends an item to the front of the deque slice in O(1) amortized
+//(same as $name_front_append), returns 0 on failure and 1 on success.
+int $name_push_front ($name* the_thing,type arg);
+
+//int $name_pop_back ($name* the_thing,type* result) puts the last element of the deque slice into result(if not null and len >0)
+//and, shrinks the slice by 1 (same as $name_pop), returns 1 on success and 0 on error.
+int $name_pop_back ($name* the_thing,type* result);
+
+//int $name_pop_front ($name* the_thing,type* result) puts the first element of the deque slice into result(if not null and len >0)
+//and, shrinks the slice by 1 in O(1) (same as $name_front_pop), returns 1 on success and 0 on error.
+int $name_pop_front ($name* the_thing,type* result);
+
+//int $name_reserve($name* the_thing,size_t new_cap) grows the capacity of the deque slice to at least new_cap,
+//returns 1 on success and 0 on error.
+int $name_reserve($name* the_thing,size_t new_cap);
+
+//void $name_make_contiguous($name* the_thing) rotates the storage so the elements are in index order from its start,
+//without allocating ($name_shrink_to_fit does it before shrinking).
+void $name_make_contiguous($name* the_thing);
+*/
+#define define_slice_deque(name,type) define_slice_deque_declarations(name,type);define_slice_deque_definitions(name,type)
+
+
+
+/*
+Small buffer slices.
+A small buffer slice stores up to N elements inside the struct itself and only allocates storage
+once it grows past N elements, so small slices never call the allocator.
+While the elements are stored inline the data pointer of the slice is NULL and its capacity is N.
+A small buffer slice provides the same functions as a regular slice ($name_append,$name_at,$name_pop,$name_destroy,...),
+$name_destroy MUST still be called since the slice may have spilled to allocated storage.
+The inline storage lives inside the struct, so a small buffer slice is copied by value like any struct, but
+pointers taken into its storage are only valid for the copy they were taken from.
+*/
+
+/*
+define_slice_sbo_struct creates a struct to act as a small buffer slice type to hold objects of type $type,
+N objects are stored inline before any storage is allocated.
+the slice has 4 attributes that should not be accessed directly unless you know what your doing,
+instead accessor functions are defined in this header that allow you to modify the slice
+*/
+#define define_slice_sbo_struct(name,type,N) SLICE_C_BEGIN typedef struct name { type* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;type SLICE_INLINE_VARAIABLE_NAME[N];} name; SLICE_C_END
+
+/*
+this macro provides access to the pointer of the storage array of a small buffer slice, inline or allocated.
+the parameter supplied must be a NON-NULL pointer to a small buffer slice object.
+*/
+#define slice_unsafe_sbo_storage_ptr(slice_ptr) (slice_unsafe_raw_storage_ptr(slice_ptr) != NULL ? slice_unsafe_raw_storage_ptr(slice_ptr) : slice_unsafe_raw_inline(slice_ptr))
+
+/*
+the number of objects a small buffer slice stores inline.
+*/
+#define slice_unsafe_sbo_inline_cap(slice_ptr) (sizeof(slice_unsafe_raw_inline(slice_ptr))/sizeof(slice_unsafe_raw_inline(slice_ptr)[0]))
+
+/*
+$name $name_make_raw (size_t cap,size_t len) creates a small buffer slice with the given capacity and length,
+storage is only allocated if cap or len is bigger than the inline capacity.
+you are encouraged to not call this function and call $name_make instead
+unless you know what your doing, when done with the slice you MUST call
+$name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_sbo_make_raw(name,type) SLICE_C_BEGIN name ___slice_function_name___(make_raw,name)(size_t cap,size_t len){\
+    name output;\
+    name* out = &output;\
+    slice_unsafe_raw_storage_ptr(out) = NULL;\
+    slice_unsafe_raw_len(out) = len;\
+    slice_unsafe_raw_cap(out) = slice_unsafe_sbo_inline_cap(out);\
+    if (len > cap){cap = len + 10;}\
+    if (cap > slice_unsafe_sbo_inline_cap(out)){\
+        slice_unsafe_raw_storage_ptr(out) = slice_calloc(type,cap);\
+        if(slice_alloc_failed(slice_unsafe_raw_storage_ptr(out))){slice_unsafe_raw_len(out) = 0;slice_unsafe_raw_cap(out) = 0;return output;}\
+        slice_unsafe_raw_cap(out) = cap;\
+    }else{\
+        SLICE_UNSAFE_MEMSET(slice_unsafe_raw_inline(out),0,len*sizeof(type));\
+    }\
+    return output;\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys a small buffer slice, this MUST be called when the slice is done being used,
+and MUST NOT be used after this function is called;
+*/
+#define define_slice_sbo_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name) (name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_free(slice_unsafe_raw_storage_ptr(the_thing));}\
+    slice_unsafe_raw_storage_ptr(the_thing)=NULL;\
+    slice_unsafe_raw_cap(the_thing)=0;slice_unsafe_raw_len(the_thing)=0;\
+    return;\
+} SLICE_C_END
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a small buffer slice is at least new_cap,
+the elements are moved out of the inline storage if it has to grow, returns 0 on failure and 1 on success.
+*/
+#define define_slice_sbo_reserve(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    type* grown;\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0){return 0;}\
+    if(new_cap <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(new_cap > slice_max_cap(type)){return 0;}\
+    grown = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),new_cap);\
+    if(slice_alloc_failed(grown)){return 0;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) == NULL){slice_memcpy(type,grown,slice_unsafe_raw_inline(the_thing),slice_unsafe_raw_len(the_thing));}\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_grow ($name* the_thing,size_t needed) makes sure the capacity of a small buffer slice is at least needed,
+the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+*/
+#define define_slice_sbo_grow(name,type) SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed){\
+    size_t new_cap;\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0){return 0;}\
+    if(needed <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    new_cap = SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),needed,sizeof(type));\
+    if(new_cap < needed){new_cap = needed;}\
+    return ___slice_function_name___(reserve,name)(the_thing,new_cap);\
+} SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of a small buffer slice to its length,
+the elements are moved back to the inline storage if they fit, returns 0 on failure and 1 on success.
+*/
+#define define_slice_sbo_shrink_to_fit(name,type) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing){\
+    type* shrunk;\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0){return 0;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(slice_unsafe_raw_len(the_thing) <= slice_unsafe_sbo_inline_cap(the_thing)){\
+        shrunk = slice_unsafe_raw_storage_ptr(the_thing);\
+        slice_memcpy(type,slice_unsafe_raw_inline(the_thing),shrunk,slice_unsafe_raw_len(the_thing));\
+        slice_free(shrunk);\
+        slice_unsafe_raw_storage_ptr(the_thing) = NULL;\
+        slice_unsafe_raw_cap(the_thing) = slice_unsafe_sbo_inline_cap(the_thing);\
+        return 1;\
+    }\
+    shrunk = slice_realloc(type,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+    if(slice_alloc_failed(shrunk)){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing) = shrunk;\
+    slice_unsafe_raw_cap(the_thing) = slice_unsafe_raw_len(the_thing);\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append ($name* the_thing,type arg) appends an item to a small buffer slice, returns 0 on failure and 1 on success,
+this grows the array as nessecary and increases the length by 1
+*/
+#define define_slice_sbo_append(name,type) SLICE_C_BEGIN int ___slice_function_name___(append,name) (name* the_thing,type arg) {\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) ==0){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing)+1))){return 0;}\
+    slice_unsafe_sbo_storage_ptr(the_thing)[slice_unsafe_raw_len(the_thing)] = arg;\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_front_append ($name* the_thing,type arg) appends an item to the front of a small buffer slice, returns 0 on failure and 1 on success,
+this grows the array as nessecary and increases the length by 1, this shifts all the elements of the underlying array by 1.
+*/
+#define define_slice_sbo_front_append(name,type) SLICE_C_BEGIN int ___slice_function_name___(front_append,name) (name* the_thing,type arg) {\
+    type* storage;\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) ==0){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing)+1))){return 0;}\
+    storage = slice_unsafe_sbo_storage_ptr(the_thing);\
+    slice_memmove(type,storage+1,storage,slice_unsafe_raw_len(the_thing));\
+    storage[0] = arg;\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a small buffer slice,
+returns 0 on failure and 1 on success, src must not point into the storage of the_thing.
+*/
+#define define_slice_sbo_append_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n){\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0||(src == NULL && n != 0)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    slice_memcpy(type,slice_unsafe_sbo_storage_ptr(the_thing) + slice_unsafe_raw_len(the_thing),src,n);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n) inserts n items from src before index 'index' (index <= length)
+of a small buffer slice, returns 0 on failure and 1 on success, the array is grown at most once and the elements after index
+are shifted with a single memmove, src must not point into the storage of the_thing.
+*/
+#define define_slice_sbo_insert_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,size_t index,const type* src,size_t n){\
+    type* storage;\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0||(src == NULL && n != 0)){return 0;}\
+    if(index > slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    storage = slice_unsafe_sbo_storage_ptr(the_thing);\
+    slice_memmove(type,storage + index + n,storage + index,slice_unsafe_raw_len(the_thing) - index);\
+    slice_memcpy(type,storage + index,src,n);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_erase_range ($name* the_thing,size_t first,size_t last) removes the items in [first,last) from a small buffer slice
+(first <= last <= length), the elements after last are shifted with a single memmove, returns 0 on failure and 1 on success.
+*/
+#define define_slice_sbo_erase_range(name,type) SLICE_C_BEGIN int ___slice_function_name___(erase_range,name)(name* the_thing,size_t first,size_t last){\
+    type* storage;\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0){return 0;}\
+    if(first > last || last > slice_unsafe_raw_len(the_thing)){return 0;}\
+    storage = slice_unsafe_sbo_storage_ptr(the_thing);\
+    slice_memmove(type,storage + first,storage + last,slice_unsafe_raw_len(the_thing) - last);\
+    slice_unsafe_raw_len(the_thing) -= last - first;\
+    return 1;\
+} SLICE_C_END
+
+/*
+$type $name_at(name* the_thing,size_t index) returns the value at an index of a small buffer slice,
+this function should only be called if you know index < the slice length, if
+you dont know you may use the $name_bounded_at function
+*/
+#define define_slice_sbo_at(name,type)  SLICE_C_BEGIN type ___slice_function_name___(at,name)(name* the_thing,size_t index){\
+    return slice_unsafe_sbo_storage_ptr(the_thing)[index];\
+} SLICE_C_END
+
+/*
+void $name_set(name* the_thing,size_t index,$type result) sets the value at an index of a small buffer slice,
+this function should only be called if you know index < the slice length, if
+you dont know you may use the $name_bounded_set function
+*/
+#define define_slice_sbo_set(name,type)  SLICE_C_BEGIN void ___slice_function_name___(set,name)(name* the_thing,size_t index,type result){\
+    slice_unsafe_sbo_storage_ptr(the_thing)[index] = result;\
+    return;\
+} SLICE_C_END
+
+/*
+ int $name_bounded_at ($name* the_thing,size_t index,type* result) gets the value of a small buffer slice at index 'index' and fills the value into result,
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_sbo_bounded_at(name,type) SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,type* result){\
+    if(the_thing == NULL || result == NULL || index >= slice_unsafe_raw_len(the_thing) || slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)) {return 0;}\
+    *result = slice_unsafe_sbo_storage_ptr(the_thing)[index];\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_bounded_set ($name* the_thing,size_t index,type result) sets the value of a small buffer slice at index 'index' to result,
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_sbo_bounded_set(name,type) SLICE_C_BEGIN int ___slice_function_name___(bounded_set,name)(name* the_thing,size_t index,type result){\
+    if(the_thing == NULL || index >= slice_unsafe_raw_len(the_thing) || slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)) {return 0;}\
+    slice_unsafe_sbo_storage_ptr(the_thing)[index] = result;\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_pop ($name* the_thing,type* result) puts the last element of a small buffer slice into result(if not null and len >0) and, shrinks the slice by 1;
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_sbo_pop(name,type) SLICE_C_BEGIN int ___slice_function_name___(pop,name)(name* the_thing,type* result){\
+    if(the_thing == NULL || slice_unsafe_raw_cap(the_thing) == 0) {return 0;}\
+    if(result == NULL) {if(slice_unsafe_raw_len(the_thing)){slice_unsafe_raw_len(the_thing)--;}return 1;}\
+    if(!slice_unsafe_raw_len(the_thing)){return 0;}\
+    *result = slice_unsafe_sbo_storage_ptr(the_thing)[slice_unsafe_raw_len(the_thing)-1];\
+    slice_unsafe_raw_len(the_thing)--;\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_front_pop ($name* the_thing,type* result) puts the first element of a small buffer slice into result(if not null and len >0) and, shrinks the slice by 1;
+ this functions shifts all elemens in the underlying array by 1.
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_sbo_front_pop(name,type) SLICE_C_BEGIN int ___slice_function_name___(front_pop,name)(name* the_thing,type* result){\
+    type* storage;\
+    if(the_thing == NULL || slice_unsafe_raw_cap(the_thing) == 0) {return 0;}\
+    if(!slice_unsafe_raw_len(the_thing)){return result == NULL;}\
+    storage = slice_unsafe_sbo_storage_ptr(the_thing);\
+    if(result != NULL){*result = storage[0];}\
+    slice_memmove(type,storage,storage+1,slice_unsafe_raw_len(the_thing)-1);\
+    slice_unsafe_raw_len(the_thing)--;\
+    return 1;\
+} SLICE_C_END
+
+/*
+$name_view $name_as_view($name* the_thing) makes a view of every element of a small buffer slice, inline or allocated,
+the view is invalidated when the elements move between the inline and the allocated storage (or the slice is copied).
+*/
+#define define_slice_sbo_as_view(name,type) SLICE_C_BEGIN ___slice_function_name___(view,name) ___slice_function_name___(as_view,name)(name* the_thing){\
+    if(the_thing == NULL||slice_unsafe_raw_cap(the_thing) == 0){return ___slice_function_name___(view_make,name)(NULL,0);}\
+    return ___slice_function_name___(view_make,name)(slice_unsafe_sbo_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+} SLICE_C_END
+
+/*
+int $name_ok(name the_thing) returns 1 if the small buffer slice is ok to use, 0 otherwise.
+*/
+#define define_slice_sbo_ok(name,type) SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing) {\
+    return slice_unsafe_value_cap(the_thing) != 0 && slice_unsafe_value_len(the_thing) <= slice_unsafe_value_cap(the_thing);\
+} SLICE_C_END
+
+/*
+int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of a small buffer slice,
+returns 1 on success and 0 on error
+*/
+#define define_slice_sbo_resize(name,type)  SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size){\
+    if(the_thing == NULL || slice_unsafe_raw_cap(the_thing) == 0) {return 0;}\
+    if(new_size > slice_unsafe_raw_cap(the_thing) && slice_grow_failed(___slice_function_name___(grow,name)(the_thing,new_size))){return 0;}\
+    slice_unsafe_raw_len(the_thing) = new_size;\
+    return 1;\
+} SLICE_C_END
+
+/*
+define_slice_sbo_all_funct_decl(name,type) creates all the function declarations needed to create a small buffer slice.
+*/
+#define define_slice_sbo_all_funct_decl(name,type) define_slice_make_raw_decl(name,type);\
+define_slice_make_decl(name,type);\
+define_slice_destroy_decl(name,type);\
+define_slice_reserve_decl(name,type);\
+define_slice_grow_decl(name,type);\
+define_slice_shrink_to_fit_decl(name,type);\
+define_slice_append_decl(name,type);\
+define_slice_front_append_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+define_slice_insert_n_decl(name,type);\
+define_slice_erase_range_decl(name,type);\
+define_slice_at_decl(name,type);\
+define_slice_set_decl(name,type);\
+define_slice_bounded_at_decl(name,type);\
+define_slice_bounded_set_decl(name,type);\
+define_slice_pop_decl(name,type);\
+define_slice_front_pop_decl(name,type);\
+define_slice_ok_decl(name,type);\
+define_slice_length_decl(name);\
+define_slice_cap_decl(name);\
+define_slice_resize_decl(name,type)
+
+/*
+define_slice_sbo_declarations(name,type,N) creates a small buffer slice named $name to act as a dynamic array container for $type
+that stores its first N elements inline.
+It will create a struct declaration and all function declarations to
+provide a means to utilize the struct
+The created struct will have declaration
+typedef struct $name {
+    $type* data;
+    size_t len;
+    size_t cap;
+    $type inline_data[N];
+} $name;
+*/
+#define define_slice_sbo_declarations(name,type,N) define_slice_sbo_struct(name,type,N);define_slice_sbo_all_funct_decl(name,type);define_slice_view_decl(name,type)
+
+/*
+define_slice_sbo_definitions(name,type) creates all the function definitions to use a small buffer slice.
+define_slice_sbo_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_sbo_struct).
+*/
+#define define_slice_sbo_definitions(name,type) define_slice_sbo_make_raw(name,type);\
+define_slice_make(name,type);\
+define_slice_sbo_destroy(name,type);\
+define_slice_sbo_reserve(name,type);\
+define_slice_sbo_grow(name,type);\
+define_slice_sbo_shrink_to_fit(name,type);\
+define_slice_sbo_append(name,type);\
+define_slice_sbo_front_append(name,type);\
+define_slice_sbo_append_n(name,type);\
+define_slice_sbo_insert_n(name,type);\
+define_slice_sbo_erase_range(name,type);\
+define_slice_sbo_at(name,type);\
+define_slice_sbo_set(name,type);\
+define_slice_sbo_bounded_at(name,type);\
+define_slice_sbo_bounded_set(name,type);\
+define_slice_sbo_pop(name,type);\
+define_slice_sbo_front_pop(name,type);\
+define_slice_sbo_ok(name,type);\
+define_slice_length(name);\
+define_slice_cap(name);\
+define_slice_sbo_resize(name,type);\
+define_slice_sbo_as_view(name,type);\
+define_slice_view_common_definitions(name,type);
+
+/*
+define_slice_sbo(name,type,N) creates a small buffer slice named $name to act as a dynamic array container for $type,
+the first N elements are stored inside the struct and storage is only allocated once the slice grows past N elements.
+It will create a struct declaration and function declarations to
+provide a means to utilize the struct.
+It will also define all the functions,
+so if you wish to seperate the functions from
+the declearations you may use
+define_slice_sbo_declarations(name,type,N) and define_slice_sbo_definitions(name,type).
+It will create the following functions, they behave like the functions of a slice created by define_slice(name,type):
+
+$name $name_make (size_t cap);
+$name $name_make_raw (size_t cap,size_t len);
+void $name_destroy(name* the_thing);
+int $name_reserve ($name* the_thing,size_t new_cap);
+int $name_grow ($name* the_thing,size_t needed);
+int $name_shrink_to_fit ($name* the_thing); //moves the elements back inline if they fit
+int $name_append ($name* the_thing,type arg);
+int $name_front_append ($name* the_thing,type arg);
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+int $name_insert_n ($name* the_thing,size_t index,const type* src,size_t n);
+int $name_erase_range ($name* the_thing,size_t first,size_t last);
+$type $name_at(name* the_thing,size_t index)
+void $name_set(name* the_thing,size_t index,$type result);
+int $name_bounded_at ($name* the_thing,size_t index,type* result);
+int $name_bounded_set ($name* the_thing,size_t index,type result);
+int $name_pop($name* the_thing,type* result);
+int $name_front_pop ($name* the_thing,type* result);
+int $name_ok(name the_thing);
+size_t $name_length(name the_thing);
+size_t $name_cap(name the_thing);
+int $name_resize($name* slice,size_t new_len);
+and the view functions ($name_as_view,$name_subslice,$name_view_at,...).
+*/
+#define define_slice_sbo(name,type,N) define_slice_sbo_declarations(name,type,N);define_slice_sbo_definitions(name,type)
+
+
+
+/*
+Allocator slices.
+The allocators set with SLICE_UNSAFE_*_ALLOCATOR are used by every slice type and have no context.
+An allocator slice instead carries a pointer to a slice_allocator, so every slice may use its own allocator,
+for example a slice_arena that releases all the slices of a request at once.
+An allocator slice has the same fields and functions as a regular slice, except that
+$name_make and $name_make_raw take the allocator to use (NULL means the heap, through SLICE_UNSAFE_*_ALLOCATOR).
+*/
+
+/*
+slice_allocator is an allocator with a context,
+reallocate(ctx,ptr,old_size,new_size) must behave like realloc (ptr may be NULL, in which case old_size is 0),
+it returns NULL on failure and leaves ptr untouched,
+release(ctx,ptr,size) releases memory returned by reallocate.
+*/
+SLICE_C_BEGIN
+typedef struct slice_allocator {
+    void* (*reallocate)(void* ctx,void* ptr,size_t old_size,size_t new_size);
+    void (*release)(void* ctx,void* ptr,size_t size);
+    void* ctx;
+} slice_allocator;
+SLICE_C_END
+
+static inline void* slice_heap_reallocate(void* ctx,void* ptr,size_t old_size,size_t new_size){
+    (void)ctx;(void)old_size;
+    return SLICE_UNSAFE_REALLOC_ALLOCATOR(ptr,new_size);
+}
+
+static inline void slice_heap_release(void* ctx,void* ptr,size_t size){
+    (void)ctx;(void)size;
+    SLICE_UNSAFE_FREE_ALLOCATOR(ptr);
+}
+
+/*
+slice_heap_allocator() returns the allocator that uses the SLICE_UNSAFE_*_ALLOCATOR functions,
+this is the allocator used when an allocator slice is made with a NULL allocator.
+*/
+static inline slice_allocator* slice_heap_allocator(void){
+    static slice_allocator heap = {slice_heap_reallocate,slice_heap_release,NULL};
+    return &heap;
+}
+
+/*
+Arenas.
+A slice_arena is a bump allocator, memory is taken from blocks allocated with SLICE_UNSAFE_REALLOC_ALLOCATOR
+and is only given back when the whole arena is reset or destroyed.
+Resetting an arena keeps its blocks on a free list for the next allocations, only destroying it frees them.
+Releasing or growing the last allocation of the arena happens in place, so a slice that is the last thing allocated
+grows without copying.
+Example
+```
+    slice_arena arena;
+    slice_arena_init(&arena,64*1024);
+    int_slice s = int_slice_make(16,slice_arena_allocator(&arena));
+    ...
+    slice_arena_reset(&arena); //releases every slice made with the arena at once, they MUST NOT be used after this
+    slice_arena_destroy(&arena);
+```
+*/
+#ifndef SLICE_ARENA_ALIGNMENT
+//the alignment of every allocation made by an arena, must be a power of 2
+#define SLICE_ARENA_ALIGNMENT 16
+#endif
+
+#define slice_arena_align(size) (((size) + (SLICE_ARENA_ALIGNMENT - 1)) & ~(size_t)(SLICE_ARENA_ALIGNMENT - 1))
+
+SLICE_C_BEGIN
+typedef struct slice_arena_block {
+    struct slice_arena_block* next;
+    size_t size;
+    size_t used;
+} slice_arena_block;
+
+typedef struct slice_arena {
+    slice_arena_block* blocks;
+    slice_arena_block* oldest;
+    slice_arena_block* free_blocks;
+    size_t block_size;
+    char* last;
+    slice_allocator allocator;
+} slice_arena;
+SLICE_C_END
+
+#define slice_arena_block_data(block) ((char*)(block) + slice_arena_align(sizeof(slice_arena_block)))
+
+static inline void* slice_arena_reallocate(void* ctx,void* ptr,size_t old_size,size_t new_size){
+    slice_arena* arena = (slice_arena*)ctx;
+    slice_arena_block* block = arena->blocks;
+    size_t need = slice_arena_align(new_size);
+    size_t offset;
+    char* out;
+    if(block != NULL && ptr != NULL && (char*)ptr == arena->last){
+        offset = (size_t)(arena->last - slice_arena_block_data(block));
+        if(offset + need <= block->size){
+            block->used = offset + need;
+            return ptr;
+        }
+    }
+    if(block == NULL || block->used + need > block->size){
+        slice_arena_block** link = &arena->free_blocks;
+        slice_arena_block* fresh;
+        while(*link != NULL && (*link)->size < need){link = &(*link)->next;}
+        fresh = *link;
+        if(fresh != NULL){*link = fresh->next;}
+        else{
+            size_t size = need > arena->block_size ? need : arena->block_size;
+            fresh = (slice_arena_block*)SLICE_UNSAFE_REALLOC_ALLOCATOR(NULL,slice_arena_align(sizeof(slice_arena_block)) + size);
+            if(fresh == NULL){return NULL;}
+            fresh->size = size;
+        }
+        fresh->next = block;
+        fresh->used = 0;
+        if(block == NULL){arena->oldest = fresh;}
+        arena->blocks = block = fresh;
+    }
+    out = slice_arena_block_data(block) + block->used;
+    block->used += need;
+    if(ptr != NULL){SLICE_UNSAFE_MEMCPY(out,ptr,old_size < new_size ? old_size : new_size);}
+    arena->last = out;
+    return out;
+}
+
+static inline void slice_arena_release(void* ctx,void* ptr,size_t size){
+    slice_arena* arena = (slice_arena*)ctx;
+    (void)size;
+    if(ptr != NULL && (char*)ptr == arena->last){
+        arena->blocks->used = (size_t)(arena->last - slice_arena_block_data(arena->blocks));
+        arena->last = NULL;
+    }
+}
+
+/*
+void slice_arena_init(slice_arena* arena,size_t block_size) initializes an arena that allocates blocks of (at least) block_size bytes,
+no memory is allocated until the first allocation.
+*/
+static inline void slice_arena_init(slice_arena* arena,size_t block_size){
+    arena->blocks = NULL;
+    arena->oldest = NULL;
+    arena->free_blocks = NULL;
+    arena->block_size = block_size ? block_size : 4096;
+    arena->last = NULL;
+    arena->allocator.reallocate = slice_arena_reallocate;
+    arena->allocator.release = slice_arena_release;
+    arena->allocator.ctx = arena;
+}
+
+/*
+slice_allocator* slice_arena_allocator(slice_arena* arena) returns the allocator to give to allocator slices to allocate from arena.
+*/
+static inline slice_allocator* slice_arena_allocator(slice_arena* arena){
+    return &arena->allocator;
+}
+
+/*
+void slice_arena_reset(slice_arena* arena) releases everything allocated from an arena at once in O(1),
+the blocks are moved to the free list in one step and reused (most recent first) by the next allocations.
+slices allocated from the arena MUST NOT be used after this function is called.
+*/
+static inline void slice_arena_reset(slice_arena* arena){
+    if(arena->blocks == NULL){return;}
+    arena->oldest->next = arena->free_blocks;
+    arena->free_blocks = arena->blocks;
+    arena->blocks = NULL;
+    arena->oldest = NULL;
+    arena->last = NULL;
+}
+
+/*
+void slice_arena_destroy(slice_arena* arena) frees every block of an arena,
+slices allocated from the arena MUST NOT be used after this function is called.
+*/
+static inline void slice_arena_destroy(slice_arena* arena){
+    slice_arena_block* next;
+    slice_arena_reset(arena);
+    while(arena->free_blocks != NULL){
+        next = arena->free_blocks->next;
+        SLICE_UNSAFE_FREE_ALLOCATOR(arena->free_blocks);
+        arena->free_blocks = next;
+    }
+}
+
+/*
+define_slice_with_allocator_struct creates a struct to act as an allocator slice type to hold objects of type $type,
+the slice has 4 attributes that should not be accessed directly unless you know what your doing,
+instead accessor functions are defined in this header that allow you to modify the slice
+*/
+#define define_slice_with_allocator_struct(name,type) SLICE_C_BEGIN typedef struct name { type* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;slice_allocator* SLICE_ALLOCATOR_VARAIABLE_NAME;} name; SLICE_C_END
+
+/*
+$name $name_make_raw (size_t cap,size_t len,slice_allocator* allocator) creates an allocator slice with the given capacity and length
+that allocates from allocator (the heap if NULL), the first len elements are zeroed.
+you are encouraged to not call this function and call $name_make instead
+unless you know what your doing, when done with the slice you MUST call
+$name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_with_allocator_make_raw_decl(name,type) SLICE_C_BEGIN name ___slice_function_name___(make_raw,name)(size_t cap,size_t len,slice_allocator* allocator); SLICE_C_END
+#define define_slice_with_allocator_make_raw(name,type) SLICE_C_BEGIN name ___slice_function_name___(make_raw,name)(size_t cap,size_t len,slice_allocator* allocator){\
+    name output = {NULL,len,cap,allocator != NULL ? allocator : slice_heap_allocator()};\
+    if(slice_unsafe_value_cap(output) == 0){slice_unsafe_value_cap(output)+=10;}\
+    if (slice_unsafe_value_len(output) > slice_unsafe_value_cap(output)){slice_unsafe_value_cap(output) = slice_unsafe_value_len(output) + 10;}\
+    if (slice_unsafe_value_cap(output) > slice_max_cap(type)){slice_unsafe_value_len(output) = 0;slice_unsafe_value_cap(output) = 0;return output;}\
+    slice_unsafe_value_storage_ptr(output) = (type*)slice_unsafe_value_allocator(output)->reallocate(slice_unsafe_value_allocator(output)->ctx,NULL,0,slice_unsafe_value_cap(output)*sizeof(type));\
+    if(slice_alloc_failed(slice_unsafe_value_storage_ptr(output))){slice_unsafe_value_len(output) = 0;slice_unsafe_value_cap(output) = 0;return output;}\
+    SLICE_UNSAFE_MEMSET(slice_unsafe_value_storage_ptr(output),0,slice_unsafe_value_len(output)*sizeof(type));\
+    slice_stats_add(name,SLICE_STATS_MAKES,1);\
+    slice_stats_peak(name,slice_unsafe_value_cap(output));\
+    return output;\
+} SLICE_C_END
+
+/*
+$name $name_make (size_t cap,slice_allocator* allocator) creates an allocator slice with the given capacity that allocates from
+allocator (the heap if NULL), when done with the slice you MUST call $name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_with_allocator_make_decl(name,type) SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t cap,slice_allocator* allocator); SLICE_C_END
+#define define_slice_with_allocator_make(name,type) SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t cap,slice_allocator* allocator){\
+    return ___slice_function_name___(make_raw,name)(cap,0,allocator);\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys an allocator slice, giving its storage back to its allocator,
+this MUST be called when the slice is done being used (unless its arena is reset or destroyed),
+and MUST NOT be used after this function is called;
+*/
+#define define_slice_with_allocator_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name) (name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){\
+        slice_stats_add(name,SLICE_STATS_DESTROYS,1);\
+        if(slice_unsafe_raw_len(the_thing) < slice_unsafe_raw_cap(the_thing)){slice_stats_add(name,SLICE_STATS_WASTED_BYTES,(slice_unsafe_raw_cap(the_thing) - slice_unsafe_raw_len(the_thing))*sizeof(type));}\
+        slice_unsafe_raw_allocator(the_thing)->release(slice_unsafe_raw_allocator(the_thing)->ctx,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_cap(the_thing)*sizeof(type));\
+    }\
+    slice_unsafe_raw_storage_ptr(the_thing)=NULL;\
+    slice_unsafe_raw_cap(the_thing)=0;slice_unsafe_raw_len(the_thing)=0;\
+    return;\
+} SLICE_C_END
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of an allocator slice is at least new_cap,
+the capacity is set to exactly new_cap if it has to grow, returns 0 on failure and 1 on success.
+*/
+#define define_slice_with_allocator_reserve(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    type* grown;\
+    slice_stats_realloc_decl\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(new_cap <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(new_cap > slice_max_cap(type)){return 0;}\
+    slice_stats_realloc_begin(slice_unsafe_raw_storage_ptr(the_thing))\
+    grown = (type*)slice_unsafe_raw_allocator(the_thing)->reallocate(slice_unsafe_raw_allocator(the_thing)->ctx,slice_unsafe_raw_storage_ptr(the_thing),\
+        slice_unsafe_raw_cap(the_thing)*sizeof(type),new_cap*sizeof(type));\
+    if(slice_alloc_failed(grown)){return 0;}\
+    slice_stats_realloc_end(name,grown,slice_unsafe_raw_cap(the_thing),new_cap,sizeof(type));\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) shrinks the capacity of an allocator slice to its length (at least 1),
+returns 0 on failure and 1 on success, the slice is left untouched on failure.
+*/
+#define define_slice_with_allocator_shrink_to_fit(name,type) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing){\
+    type* shrunk;\
+    size_t new_cap;\
+    slice_stats_realloc_decl\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    new_cap = slice_unsafe_raw_len(the_thing) ? slice_unsafe_raw_len(the_thing) : 1;\
+    if(new_cap >= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    slice_stats_realloc_begin(slice_unsafe_raw_storage_ptr(the_thing))\
+    shrunk = (type*)slice_unsafe_raw_allocator(the_thing)->reallocate(slice_unsafe_raw_allocator(the_thing)->ctx,slice_unsafe_raw_storage_ptr(the_thing),\
+        slice_unsafe_raw_cap(the_thing)*sizeof(type),new_cap*sizeof(type));\
+    if(slice_alloc_failed(shrunk)){return 0;}\
+    slice_stats_realloc_end(name,shrunk,slice_unsafe_raw_cap(the_thing),new_cap,sizeof(type));\
+    slice_unsafe_raw_storage_ptr(the_thing) = shrunk;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+define_slice_with_allocator_all_funct_decl(name,type) creates all the function declarations needed to create an allocator slice.
+*/
+#define define_slice_with_allocator_all_funct_decl(name,type) define_slice_with_allocator_make_raw_decl(name,type);\
+define_slice_with_allocator_make_decl(name,type);\
+define_slice_destroy_decl(name,type);\
+define_slice_append_decl(name,type);\
+define_slice_at_decl(name,type);\
+define_slice_set_decl(name,type);\
+define_slice_bounded_at_decl(name,type);\
+define_slice_bounded_set_decl(name,type);\
+define_slice_pop_decl(name,type);\
+define_slice_front_pop_decl(name,type);\
+define_slice_ok_decl(name,type);\
+define_slice_length_decl(name);\
+define_slice_front_append_decl(name,type);\
+define_slice_cap_decl(name);\
+define_slice_resize_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+define_slice_insert_n_decl(name,type);\
+define_slice_erase_range_decl(name,type);\
+define_slice_reserve_decl(name,type);\
+define_slice_grow_decl(name,type);\
+define_slice_shrink_to_fit_decl(name,type)
+
+/*
+define_slice_with_allocator_declarations(name,type) creates an allocator slice named $name to act as a dynamic array container for $type.
+It will create a struct declaration and all function declarations to
+provide a means to utilize the struct
+The created struct will have declaration
+typedef struct $name {
+    $type* data;
+    size_t len;
+    size_t cap;
+    slice_allocator* allocator;
+} $name;
+*/
+#define define_slice_with_allocator_declarations(name,type) define_slice_with_allocator_struct(name,type);define_slice_with_allocator_all_funct_decl(name,type);define_slice_view_decl(name,type)
+
+/*
+define_slice_with_allocator_definitions(name,type) creates all the function definitions to use an allocator slice.
+define_slice_with_allocator_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_with_allocator_struct).
+Only the functions that allocate differ from a regular slice, the others are the regular slice functions.
+*/
+#define define_slice_with_allocator_definitions(name,type) define_slice_stats(name,type)\
+define_slice_with_allocator_make_raw(name,type);\
+define_slice_with_allocator_make(name,type);\
+define_slice_with_allocator_destroy(name,type);\
+define_slice_append(name,type);\
+define_slice_front_append(name,type);\
+define_slice_at(name,type);\
+define_slice_set(name,type);\
+define_slice_bounded_at(name,type);\
+define_slice_bounded_set(name,type);\
+define_slice_pop(name,type);\
+define_slice_front_pop(name,type);\
+define_slice_ok(name,type);\
+define_slice_length(name);\
+define_slice_cap(name);\
+define_slice_resize(name,type);\
+define_slice_append_n(name,type);\
+define_slice_insert_n(name,type);\
+define_slice_erase_range(name,type);\
+define_slice_with_allocator_reserve(name,type);\
+define_slice_grow(name,type);\
+define_slice_with_allocator_shrink_to_fit(name,type);\
+define_slice_view_definitions(name,type);
+
+/*
+define_slice_with_allocator(name,type) creates an allocator slice named $name to act as a dynamic array container for $type
+whose storage comes from the slice_allocator given to $name_make.
+It will create a struct declaration and function declarations to
+provide a means to utilize the struct.
+It will also define all the functions,
+so if you wish to seperate the functions from
+the declearations you may use
+define_slice_with_allocator_declarations(name,type) and define_slice_with_allocator_definitions(name,type).
+It will create every function a slice created by define_slice(name,type) has, except that
+
+//$name $name_make (size_t cap,slice_allocator* allocator) creates an allocator slice with the given capacity that allocates from
+//allocator (the heap if NULL), when done with the slice you MUST call $name_destroy on it to prevent memory leaks.
+$name $name_make (size_t cap,slice_allocator* allocator);
+
+//$name $name_make_raw (size_t cap,size_t len,slice_allocator* allocator) creates an allocator slice with the given capacity and length
+//that allocates from allocator (the heap if NULL).
+$name $name_make_raw (size_t cap,size_t len,slice_allocator* allocator);
+*/
+#define define_slice_with_allocator(name,type) define_slice_with_allocator_declarations(name,type);define_slice_with_allocator_definitions(name,type)
+
+
+
+/*
+Segmented slices.
+A segmented slice stores its elements in fixed size chunks of CHUNK elements and keeps a directory of pointers to the chunks.
+Growing allocates new chunks and only reallocates the (small) directory, existing elements are never moved,
+so pointers returned by $name_at_ptr stay valid across appends and growing never copies the elements.
+Element index i lives in chunk i/CHUNK at offset i%CHUNK, CHUNK is a compile time constant so if it is a power of 2
+the compiler turns this into a shift and a mask.
+A segmented slice has the regular slice functions except $name_front_append and $name_front_pop, which would have to move every element.
+*/
+
+/*
+define_slice_segmented_struct creates a struct to act as a segmented slice type to hold objects of type $type,
+the slice has 4 attributes that should not be accessed directly unless you know what your doing,
+instead accessor functions are defined in this header that allow you to modify the slice
+*/
+#define define_slice_segmented_struct(name,type) SLICE_C_BEGIN typedef struct name { type** SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;size_t chunks_cap;} name; SLICE_C_END
+
+/*
+this macro provides access to get a value at an index in a segmented slice with chunks of CHUNK elements.
+the parameter supplied must be a NON-NULL pointer to a segmented slice object.
+you should only use this function if you know index < the slice capacity.
+*/
+#define slice_unsafe_segmented_get(slice_ptr,index,CHUNK) slice_unsafe_raw_storage_ptr(slice_ptr)[(index)/(CHUNK)][(index)%(CHUNK)]
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a segmented slice is at least new_cap
+by allocating chunks, existing elements are not moved, returns 0 on failure and 1 on success.
+*/
+#define define_slice_segmented_reserve(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    size_t chunks,have,dir_cap;\
+    type** dir;\
+    type* chunk;\
+    if(the_thing == NULL){return 0;}\
+    if(new_cap <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(new_cap > slice_max_cap(type) - (CHUNK)){return 0;}\
+    chunks = (new_cap + (CHUNK) - 1)/(CHUNK);\
+    have = slice_unsafe_raw_cap(the_thing)/(CHUNK);\
+    if(chunks > the_thing->chunks_cap){\
+        dir_cap = SLICE_GROWTH_POLICY(the_thing->chunks_cap,chunks,sizeof(type*));\
+        if(dir_cap < chunks){dir_cap = chunks;}\
+        dir = slice_realloc(type*,slice_unsafe_raw_storage_ptr(the_thing),dir_cap);\
+        if(slice_alloc_failed(dir)){return 0;}\
+        slice_unsafe_raw_storage_ptr(the_thing) = dir;\
+        the_thing->chunks_cap = dir_cap;\
+    }\
+    for(;have < chunks;have++){\
+        chunk = slice_calloc(type,(CHUNK));\
+        if(slice_alloc_failed(chunk)){return 0;}\
+        slice_unsafe_raw_storage_ptr(the_thing)[have] = chunk;\
+        slice_unsafe_raw_cap(the_thing) = (have + 1)*(CHUNK);\
+    }\
+    return 1;\
+} SLICE_C_END
+
+/*
+$name $name_make_raw (size_t cap,size_t len) creates a segmented slice with (at least) the given capacity and length,
+you are encouraged to not call this function and call $name_make instead
+unless you know what your doing, when done with the slice you MUST call
+$name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_segmented_make_raw(name,type,CHUNK) SLICE_C_BEGIN name ___slice_function_name___(make_raw,name)(size_t cap,size_t len){\
+    name output = {NULL,0,0,0};\
+    if(cap == 0){cap = 1;}\
+    if(len > cap){cap = len;}\
+    if(___slice_function_name___(reserve,name)(&output,cap)){slice_unsafe_value_len(output) = len;}\
+    return output;\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys a segmented slice, this MUST be called when the slice is done being used,
+and MUST NOT be used after this function is called;
+*/
+#define define_slice_segmented_destroy(name,type,CHUNK) SLICE_C_BEGIN void ___slice_function_name___(destroy,name) (name* the_thing){\
+    size_t i;\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){\
+        for(i = 0;i < slice_unsafe_raw_cap(the_thing)/(CHUNK);i++){slice_free(slice_unsafe_raw_storage_ptr(the_thing)[i]);}\
+        slice_free(slice_unsafe_raw_storage_ptr(the_thing));\
+    }\
+    slice_unsafe_raw_storage_ptr(the_thing)=NULL;\
+    slice_unsafe_raw_cap(the_thing)=0;slice_unsafe_raw_len(the_thing)=0;the_thing->chunks_cap=0;\
+    return;\
+} SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) frees the chunks of a segmented slice past its length (the first chunk is kept),
+returns 1 on success and 0 on error.
+*/
+#define define_slice_segmented_shrink_to_fit(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing){\
+    size_t keep,have;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    keep = (slice_unsafe_raw_len(the_thing) + (CHUNK) - 1)/(CHUNK);\
+    if(keep == 0){keep = 1;}\
+    have = slice_unsafe_raw_cap(the_thing)/(CHUNK);\
+    for(;have > keep;have--){slice_free(slice_unsafe_raw_storage_ptr(the_thing)[have-1]);}\
+    slice_unsafe_raw_cap(the_thing) = have*(CHUNK);\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append ($name* the_thing,type arg) appends an item to a segmented slice, returns 0 on failure and 1 on success,
+this allocates a new chunk as nessecary and increases the length by 1, no element is moved.
+*/
+#define define_slice_segmented_append(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(append,name) (name* the_thing,type arg) {\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) >= slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,slice_unsafe_raw_len(the_thing)+1))){return 0;}\
+    slice_unsafe_segmented_get(the_thing,slice_unsafe_raw_len(the_thing),CHUNK) = arg;\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a segmented slice,
+copying with one memcpy per chunk, returns 0 on failure and 1 on success.
+*/
+#define define_slice_segmented_append_n(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n){\
+    size_t len,count;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||(src == NULL && n != 0)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_unsafe_raw_len(the_thing) + n > slice_unsafe_raw_cap(the_thing) && \
+        slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    len = slice_unsafe_raw_len(the_thing);\
+    while(n != 0){\
+        count = (CHUNK) - len%(CHUNK);\
+        if(count > n){count = n;}\
+        slice_memcpy(type,&slice_unsafe_segmented_get(the_thing,len,CHUNK),src,count);\
+        len += count;src += count;n -= count;\
+    }\
+    slice_unsafe_raw_len(the_thing) = len;\
+    return 1;\
+} SLICE_C_END
+
+/*
+type* $name_at_ptr(name* the_thing,size_t index) returns a pointer to the element at an index of a segmented slice,
+the pointer stays valid until the slice is destroyed or shrunk, even if the slice grows.
+this function should only be called if you know index < the slice length.
+*/
+#define define_slice_segmented_at_ptr(name,type,CHUNK)  SLICE_C_BEGIN type* ___slice_function_name___(at_ptr,name)(name* the_thing,size_t index){\
+    return &slice_unsafe_segmented_get(the_thing,index,CHUNK);\
+} SLICE_C_END
+
+/*
+$type $name_at(name* the_thing,size_t index) returns the value at an index of a segmented slice,
+this function should only be called if you know index < the slice length, if
+you dont know you may use the $name_bounded_at function
+*/
+#define define_slice_segmented_at(name,type,CHUNK)  SLICE_C_BEGIN type ___slice_function_name___(at,name)(name* the_thing,size_t index){\
+    return slice_unsafe_segmented_get(the_thing,index,CHUNK);\
+} SLICE_C_END
+
+/*
+void $name_set(name* the_thing,size_t index,$type result) sets the value at an index of a segmented slice,
+this function should only be called if you know index < the slice length, if
+you dont know you may use the $name_bounded_set function
+*/
+#define define_slice_segmented_set(name,type,CHUNK)  SLICE_C_BEGIN void ___slice_function_name___(set,name)(name* the_thing,size_t index,type result){\
+    slice_unsafe_segmented_get(the_thing,index,CHUNK) = result;\
+    return;\
+} SLICE_C_END
+
+/*
+ int $name_bounded_at ($name* the_thing,size_t index,type* result) gets the value of a segmented slice at index 'index' and fills the value into result,
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_segmented_bounded_at(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,type* result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL || result == NULL || slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)) {return 0;}\
+    if(index >= slice_unsafe_raw_len(the_thing)) {return 0;}\
+    *result = slice_unsafe_segmented_get(the_thing,index,CHUNK);\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_bounded_set ($name* the_thing,size_t index,type result) sets the value of a segmented slice at index 'index' to result,
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_segmented_bounded_set(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(bounded_set,name)(name* the_thing,size_t index,type result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL || slice_unsafe_raw_len(the_thing) > slice_unsafe_raw_cap(the_thing)) {return 0;}\
+    if(index >= slice_unsafe_raw_len(the_thing)) {return 0;}\
+    slice_unsafe_segmented_get(the_thing,index,CHUNK) = result;\
+    return 1;\
+} SLICE_C_END
+
+/*
+ int $name_pop ($name* the_thing,type* result) puts the last element of a segmented slice into result(if not null and len >0) and, shrinks the slice by 1;
+ returns 1 on success and 0 on error.
+*/
+#define define_slice_segmented_pop(name,type,CHUNK) SLICE_C_BEGIN int ___slice_function_name___(pop,name)(name* the_thing,type* result){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
+    if(result == NULL) {if(slice_unsafe_raw_len(the_thing)){slice_unsafe_raw_len(the_thing)--;}return 1;}\
+    if(!slice_unsafe_raw_len(the_thing)){return 0;}\
+    *result = slice_unsafe_segmented_get(the_thing,slice_unsafe_raw_len(the_thing)-1,CHUNK);\
+    slice_unsafe_raw_len(the_thing)--;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_resize($name* slice,size_t new_len) sets the length(and maybe capacity) of a segmented slice,
+returns 1 on success and 0 on error
+*/
+#define define_slice_segmented_resize(name,type,CHUNK)  SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size){\
+    if(the_thing == NULL || slice_unsafe_raw_storage_ptr(the_thing) == NULL) {return 0;}\
+    if(new_size > slice_unsafe_raw_cap(the_thing) && slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,new_size))){return 0;}\
+    slice_unsafe_raw_len(the_thing) = new_size;\
+    return 1;\
+} SLICE_C_END
+
+/*
+define_slice_segmented_all_funct_decl(name,type) creates all the function declarations needed to create a segmented slice.
+*/
+#define define_slice_segmented_all_funct_decl(name,type) define_slice_make_raw_decl(name,type);\
+define_slice_make_decl(name,type);\
+define_slice_destroy_decl(name,type);\
+define_slice_reserve_decl(name,type);\
+define_slice_shrink_to_fit_decl(name,type);\
+define_slice_append_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+SLICE_C_BEGIN type* ___slice_function_name___(at_ptr,name)(name* the_thing,size_t index); SLICE_C_END;\
+define_slice_at_decl(name,type);\
+define_slice_set_decl(name,type);\
+define_slice_bounded_at_decl(name,type);\
+define_slice_bounded_set_decl(name,type);\
+define_slice_pop_decl(name,type);\
+define_slice_ok_decl(name,type);\
+define_slice_length_decl(name);\
+define_slice_cap_decl(name);\
+define_slice_resize_decl(name,type)
+
+/*
+define_slice_segmented_declarations(name,type) creates a segmented slice named $name to act as a dynamic array container for $type.
+It will create a struct declaration and all function declarations to
+provide a means to utilize the struct
+The created struct will have declaration
+typedef struct $name {
+    $type** data;
+    size_t len;
+    size_t cap;
+    size_t chunks_cap;
+} $name;
+*/
+#define define_slice_segmented_declarations(name,type) define_slice_segmented_struct(name,type);define_slice_segmented_all_funct_decl(name,type)
+
+/*
+define_slice_segmented_definitions(name,type,CHUNK) creates all the function definitions to use a segmented slice with chunks of CHUNK elements.
+define_slice_segmented_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_segmented_struct).
+*/
+#define define_slice_segmented_definitions(name,type,CHUNK) define_slice_segmented_reserve(name,type,CHUNK);\
+define_slice_segmented_make_raw(name,type,CHUNK);\
+define_slice_make(name,type);\
+define_slice_segmented_destroy(name,type,CHUNK);\
+define_slice_segmented_shrink_to_fit(name,type,CHUNK);\
+define_slice_segmented_append(name,type,CHUNK);\
+define_slice_segmented_append_n(name,type,CHUNK);\
+define_slice_segmented_at_ptr(name,type,CHUNK);\
+define_slice_segmented_at(name,type,CHUNK);\
+define_slice_segmented_set(name,type,CHUNK);\
+define_slice_segmented_bounded_at(name,type,CHUNK);\
+define_slice_segmented_bounded_set(name,type,CHUNK);\
+define_slice_segmented_pop(name,type,CHUNK);\
+define_slice_ok(name,type);\
+define_slice_length(name);\
+define_slice_cap(name);\
+define_slice_segmented_resize(name,type,CHUNK);
+
+/*
+define_slice_segmented(name,type,CHUNK) creates a segmented slice named $name to act as a dynamic array container for $type
+that stores its elements in chunks of CHUNK elements (a power of 2 is recommended) and never moves them.
+It will create a struct declaration and function declarations to
+provide a means to utilize the struct.
+It will also define all the functions,
+so if you wish to seperate the functions from
+the declearations you may use
+define_slice_segmented_declarations(name,type) and define_slice_segmented_definitions(name,type,CHUNK).
+It will create the following functions, they behave like the functions of a slice created by define_slice(name,type):
+
+$name $name_make (size_t cap);
+$name $name_make_raw (size_t cap,size_t len);
+void $name_destroy(name* the_thing);
+int $name_reserve ($name* the_thing,size_t new_cap);
+int $name_shrink_to_fit ($name* the_thing); //frees the chunks past the length
+int $name_append ($name* the_thing,type arg);
+int $name_append_n ($name* the_thing,const type* src,size_t n);
+$type $name_at(name* the_thing,size_t index)
+void $name_set(name* the_thing,size_t index,$type result);
+int $name_bounded_at ($name* the_thing,size_t index,type* result);
+int $name_bounded_set ($name* the_thing,size_t index,type result);
+int $name_pop($name* the_thing,type* result);
+int $name_ok(name the_thing);
+size_t $name_length(name the_thing);
+size_t $name_cap(name the_thing);
+int $name_resize($name* slice,size_t new_len);
+
+//type* $name_at_ptr(name* the_thing,size_t index) returns a pointer to the element at an index,
+//the pointer stays valid across appends until the slice is destroyed or shrunk.
+type* $name_at_ptr(name* the_thing,size_t index);
+*/
+#define define_slice_segmented(name,type,CHUNK) define_slice_segmented_declarations(name,type);define_slice_segmented_definitions(name,type,CHUNK)
+
+
+
 #endif
\ No newline at end of file
@@ -0,0 +1,464 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_HPP
+
+
+#define CUSTOM_SLICES_HPP 1
+#include "slice.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+/*
+This file adds a C++11 layer over slices: slice::vec<T> is a growable slice with the same layout as a slice made
+by define_slice (a data pointer, a length and a capacity) that frees itself, moves without copying and can be used
+with <algorithm> and range for loops, slice::fixed<T,N> keeps up to N elements inline with a capacity known at compile time.
+
+Storage of a vec comes from the slice allocator (SLICE_UNSAFE_REALLOC_ALLOCATOR/SLICE_UNSAFE_FREE_ALLOCATOR) and grows
+by SLICE_GROWTH_POLICY like any other slice.
+Trivially copyable elements are grown with a realloc, any other type is relocated by move constructing every element
+into the new storage (copying if the move constructor may throw) and destroying the old ones, so types that point
+into themselves are never moved with a raw memcpy.
+Functions that have to allocate throw std::bad_alloc if the allocator returns NULL, the vec is left as it was.
+
+```
+    slice::vec<std::string> names = {"b","a"};
+    names.emplace_back(3,'c');
+    std::sort(names.begin(),names.end());
+    for(const std::string& n : names){}
+    slice::vec<std::string> moved = std::move(names);   noexcept, names is left empty
+
+    slice::fixed<int,16> small;
+    static_assert(slice::fixed<int,16>::capacity() == 16,"");
+    if(small.try_push_back(1) == nullptr){}              full
+```
+A vec of a trivially copyable type can take the storage of a C slice and give it back:
+```
+    define_slice(ints,int);
+    ints c = ints_make(10);
+    slice::vec<int> v = slice::vec<int>::adopt(c);       c is left empty (NULL data)
+    ints back = v.release<ints>();                        v is left empty, destroy back with ints_destroy
+```
+*/
+
+namespace slice {
+
+//relocates n elements from src to uninitialized storage at dst and destroys the elements at src,
+//if constructing an element throws, the elements already constructed at dst are destroyed and src is left untouched.
+template<class T>
+inline void relocate(T* dst,T* src,std::size_t n){
+    if(std::is_trivially_copyable<T>::value){
+        if(n){std::memcpy(static_cast<void*>(dst),static_cast<const void*>(src),n*sizeof(T));}
+        return;
+    }
+    std::size_t i = 0;
+    try{
+        for(;i < n;i++){::new(static_cast<void*>(dst + i)) T(std::move_if_noexcept(src[i]));}
+    }catch(...){
+        while(i){dst[--i].~T();}
+        throw;
+    }
+    for(i = 0;i < n;i++){src[i].~T();}
+}
+
+//destroys the elements [first,last).
+template<class T>
+inline void destroy(T* first,T* last){
+    if(std::is_trivially_destructible<T>::value){return;}
+    for(;first != last;++first){first->~T();}
+}
+
+/*
+slice::vec<T> is a growable array of T that owns its storage.
+The iterators are pointers, they are invalidated by anything that grows the vec.
+*/
+template<class T>
+class vec {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    vec() noexcept : ptr_(nullptr),len_(0),cap_(0) {}
+    explicit vec(size_type n) : vec() {resize(n);}
+    vec(size_type n,const T& value) : vec() {resize(n,value);}
+    vec(std::initializer_list<T> items) : vec() {
+        reserve(items.size());
+        for(const T& item : items){::new(static_cast<void*>(ptr_ + len_)) T(item);len_++;}
+    }
+    vec(const vec& other) : vec() {
+        reserve(other.len_);
+        for(;len_ < other.len_;len_++){::new(static_cast<void*>(ptr_ + len_)) T(other.ptr_[len_]);}
+    }
+    vec(vec&& other) noexcept : ptr_(other.ptr_),len_(other.len_),cap_(other.cap_) {
+        other.ptr_ = nullptr;other.len_ = 0;other.cap_ = 0;
+    }
+    ~vec(){
+        clear();
+        if(ptr_ != nullptr){slice_free(ptr_);}
+    }
+    vec& operator=(const vec& other){
+        if(this != &other){vec copy(other);swap(copy);}
+        return *this;
+    }
+    vec& operator=(vec&& other) noexcept {
+        if(this != &other){vec gone(std::move(*this));swap(other);}
+        return *this;
+    }
+
+    //takes the storage of a C slice (any struct with the fields of define_slice_struct) and leaves the slice empty,
+    //the storage MUST come from the slice allocator.
+    template<class S>
+    static vec adopt(S& c_slice) noexcept {
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable elements can be shared with C slices");
+        S* from = &c_slice;
+        vec output;
+        output.ptr_ = slice_unsafe_raw_storage_ptr(from);
+        output.len_ = output.ptr_ == nullptr ? 0 : slice_unsafe_raw_len(from);
+        output.cap_ = output.ptr_ == nullptr ? 0 : slice_unsafe_raw_cap(from);
+        slice_unsafe_raw_storage_ptr(from) = nullptr;
+        slice_unsafe_raw_len(from) = 0;
+        slice_unsafe_raw_cap(from) = 0;
+        return output;
+    }
+    //gives the storage to a C slice of type S (destroy it with $name_destroy) and leaves the vec empty.
+    template<class S>
+    S release() noexcept {
+        static_assert(std::is_trivially_copyable<T>::value,"only trivially copyable elements can be shared with C slices");
+        S output;
+        slice_unsafe_value_storage_ptr(output) = ptr_;
+        slice_unsafe_value_len(output) = len_;
+        slice_unsafe_value_cap(output) = cap_;
+        ptr_ = nullptr;len_ = 0;cap_ = 0;
+        return output;
+    }
+
+    size_type size() const noexcept {return len_;}
+    size_type capacity() const noexcept {return cap_;}
+    bool empty() const noexcept {return len_ == 0;}
+    size_type max_size() const noexcept {return slice_max_cap(T);}
+    T* data() noexcept {return ptr_;}
+    const T* data() const noexcept {return ptr_;}
+
+    T& operator[](size_type index) noexcept {return ptr_[index];}
+    const T& operator[](size_type index) const noexcept {return ptr_[index];}
+    T& at(size_type index){
+        if(index >= len_){throw std::out_of_range("slice::vec::at");}
+        return ptr_[index];
+    }
+    const T& at(size_type index) const {
+        if(index >= len_){throw std::out_of_range("slice::vec::at");}
+        return ptr_[index];
+    }
+    T& front() noexcept {return ptr_[0];}
+    const T& front() const noexcept {return ptr_[0];}
+    T& back() noexcept {return ptr_[len_ - 1];}
+    const T& back() const noexcept {return ptr_[len_ - 1];}
+
+    iterator begin() noexcept {return ptr_;}
+    iterator end() noexcept {return ptr_ + len_;}
+    const_iterator begin() const noexcept {return ptr_;}
+    const_iterator end() const noexcept {return ptr_ + len_;}
+    const_iterator cbegin() const noexcept {return ptr_;}
+    const_iterator cend() const noexcept {return ptr_ + len_;}
+    reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+    reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+    const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+    const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+    //makes sure the capacity is at least new_cap, the capacity is set to exactly new_cap if it has to grow.
+    void reserve(size_type new_cap){
+        if(new_cap > cap_){reallocate(new_cap);}
+    }
+    //shrinks the capacity to the length (frees the storage of an empty vec).
+    void shrink_to_fit(){
+        if(len_ == cap_){return;}
+        if(len_ == 0){
+            slice_free(ptr_);
+            ptr_ = nullptr;cap_ = 0;
+            return;
+        }
+        reallocate(len_);
+    }
+
+    template<class... Args>
+    T& emplace_back(Args&&... args){
+        if(len_ < cap_){
+            ::new(static_cast<void*>(ptr_ + len_)) T(std::forward<Args>(args)...);
+            return ptr_[len_++];
+        }
+        return emplace_back_grow(std::forward<Args>(args)...);
+    }
+    void push_back(const T& value){emplace_back(value);}
+    void push_back(T&& value){emplace_back(std::move(value));}
+    void pop_back() noexcept {ptr_[--len_].~T();}
+
+    //inserts value before pos and returns an iterator to it.
+    iterator insert(const_iterator pos,T value){
+        size_type index = static_cast<size_type>(pos - ptr_);
+        emplace_back(std::move(value));
+        std::rotate(ptr_ + index,ptr_ + len_ - 1,ptr_ + len_);
+        return ptr_ + index;
+    }
+    //removes the elements [first,last) and returns an iterator to the element after them.
+    iterator erase(const_iterator first,const_iterator last){
+        T* to = ptr_ + (first - ptr_);
+        T* from = ptr_ + (last - ptr_);
+        T* new_end = std::move(from,ptr_ + len_,to);
+        slice::destroy(new_end,ptr_ + len_);
+        len_ = static_cast<size_type>(new_end - ptr_);
+        return to;
+    }
+    iterator erase(const_iterator pos){return erase(pos,pos + 1);}
+
+    void resize(size_type new_len){
+        if(new_len <= len_){truncate(new_len);return;}
+        grow(new_len);
+        for(;len_ < new_len;len_++){::new(static_cast<void*>(ptr_ + len_)) T();}
+    }
+    void resize(size_type new_len,const T& value){
+        if(new_len <= len_){truncate(new_len);return;}
+        if(new_len > cap_){
+            T copy(value);
+            grow(new_len);
+            for(;len_ < new_len;len_++){::new(static_cast<void*>(ptr_ + len_)) T(copy);}
+            return;
+        }
+        for(;len_ < new_len;len_++){::new(static_cast<void*>(ptr_ + len_)) T(value);}
+    }
+    void clear() noexcept {truncate(0);}
+    void swap(vec& other) noexcept {
+        std::swap(ptr_,other.ptr_);
+        std::swap(len_,other.len_);
+        std::swap(cap_,other.cap_);
+    }
+
+private:
+    T* ptr_;
+    size_type len_;
+    size_type cap_;
+
+    void truncate(size_type new_len) noexcept {
+        slice::destroy(ptr_ + new_len,ptr_ + len_);
+        len_ = new_len;
+    }
+    //grows the capacity to at least needed as chosen by SLICE_GROWTH_POLICY.
+    void grow(size_type needed){
+        if(needed <= cap_){return;}
+        size_type new_cap = SLICE_GROWTH_POLICY(cap_,needed,sizeof(T));
+        reallocate(new_cap < needed ? needed : new_cap);
+    }
+    //allocates uninitialized storage for cap elements without touching the vec.
+    static T* allocate(size_type cap){
+        if(cap > slice_max_cap(T)){throw std::bad_alloc();}
+        T* output = static_cast<T*>(SLICE_UNSAFE_REALLOC_ALLOCATOR(nullptr,cap*sizeof(T)));
+        if(output == nullptr){throw std::bad_alloc();}
+        return output;
+    }
+    //moves the elements to storage for exactly new_cap elements (new_cap >= len_).
+    void reallocate(size_type new_cap){
+        if(std::is_trivially_copyable<T>::value){
+            if(new_cap > slice_max_cap(T)){throw std::bad_alloc();}
+            T* grown = static_cast<T*>(SLICE_UNSAFE_REALLOC_ALLOCATOR(static_cast<void*>(ptr_),new_cap*sizeof(T)));
+            if(grown == nullptr){throw std::bad_alloc();}
+            ptr_ = grown;cap_ = new_cap;
+            return;
+        }
+        T* grown = allocate(new_cap);
+        try{
+            slice::relocate(grown,ptr_,len_);
+        }catch(...){
+            slice_free(grown);
+            throw;
+        }
+        if(ptr_ != nullptr){slice_free(ptr_);}
+        ptr_ = grown;cap_ = new_cap;
+    }
+    //emplace_back on a full vec, the arguments may refer to elements of the vec so the new element is built
+    //before the old storage goes away.
+    template<class... Args>
+    T& emplace_back_grow(Args&&... args){
+        size_type needed = len_ + 1;
+        size_type new_cap = SLICE_GROWTH_POLICY(cap_,needed,sizeof(T));
+        if(new_cap < needed){new_cap = needed;}
+        if(std::is_trivially_copyable<T>::value){
+            T value(std::forward<Args>(args)...);
+            reallocate(new_cap);
+            ::new(static_cast<void*>(ptr_ + len_)) T(std::move(value));
+            return ptr_[len_++];
+        }
+        T* grown = allocate(new_cap);
+        try{
+            ::new(static_cast<void*>(grown + len_)) T(std::forward<Args>(args)...);
+        }catch(...){
+            slice_free(grown);
+            throw;
+        }
+        try{
+            slice::relocate(grown,ptr_,len_);
+        }catch(...){
+            grown[len_].~T();
+            slice_free(grown);
+            throw;
+        }
+        if(ptr_ != nullptr){slice_free(ptr_);}
+        ptr_ = grown;cap_ = new_cap;
+        return ptr_[len_++];
+    }
+};
+
+template<class T>
+inline bool operator==(const vec<T>& a,const vec<T>& b){
+    return a.size() == b.size() && std::equal(a.begin(),a.end(),b.begin());
+}
+template<class T>
+inline bool operator!=(const vec<T>& a,const vec<T>& b){return !(a == b);}
+template<class T>
+inline void swap(vec<T>& a,vec<T>& b) noexcept {a.swap(b);}
+
+/*
+slice::fixed<T,N> holds up to N elements of T inline (no allocation), capacity() is a constant expression.
+push_back and emplace_back throw std::bad_alloc when the slice is full, try_push_back and try_emplace_back return nullptr instead.
+*/
+template<class T,std::size_t N>
+class fixed {
+public:
+    typedef T value_type;
+    typedef std::size_t size_type;
+    typedef std::ptrdiff_t difference_type;
+    typedef T& reference;
+    typedef const T& const_reference;
+    typedef T* pointer;
+    typedef const T* const_pointer;
+    typedef T* iterator;
+    typedef const T* const_iterator;
+    typedef std::reverse_iterator<iterator> reverse_iterator;
+    typedef std::reverse_iterator<const_iterator> const_reverse_iterator;
+
+    fixed() noexcept : len_(0) {}
+    fixed(std::initializer_list<T> items) : len_(0) {
+        if(items.size() > N){throw std::bad_alloc();}
+        for(const T& item : items){::new(static_cast<void*>(data() + len_)) T(item);len_++;}
+    }
+    fixed(const fixed& other) : len_(0) {
+        for(;len_ < other.len_;len_++){::new(static_cast<void*>(data() + len_)) T(other[len_]);}
+    }
+    fixed(fixed&& other) noexcept(std::is_nothrow_move_constructible<T>::value) : len_(0) {
+        for(;len_ < other.len_;len_++){::new(static_cast<void*>(data() + len_)) T(std::move(other[len_]));}
+        other.clear();
+    }
+    ~fixed(){clear();}
+    fixed& operator=(const fixed& other){
+        if(this != &other){clear();for(;len_ < other.len_;len_++){::new(static_cast<void*>(data() + len_)) T(other[len_]);}}
+        return *this;
+    }
+    fixed& operator=(fixed&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if(this != &other){
+            clear();
+            for(;len_ < other.len_;len_++){::new(static_cast<void*>(data() + len_)) T(std::move(other[len_]));}
+            other.clear();
+        }
+        return *this;
+    }
+
+    static constexpr size_type capacity() noexcept {return N;}
+    static constexpr size_type max_size() noexcept {return N;}
+    size_type size() const noexcept {return len_;}
+    bool empty() const noexcept {return len_ == 0;}
+    bool full() const noexcept {return len_ == N;}
+    T* data() noexcept {return reinterpret_cast<T*>(storage_);}
+    const T* data() const noexcept {return reinterpret_cast<const T*>(storage_);}
+
+    T& operator[](size_type index) noexcept {return data()[index];}
+    const T& operator[](size_type index) const noexcept {return data()[index];}
+    T& at(size_type index){
+        if(index >= len_){throw std::out_of_range("slice::fixed::at");}
+        return data()[index];
+    }
+    const T& at(size_type index) const {
+        if(index >= len_){throw std::out_of_range("slice::fixed::at");}
+        return data()[index];
+    }
+    T& front() noexcept {return data()[0];}
+    const T& front() const noexcept {return data()[0];}
+    T& back() noexcept {return data()[len_ - 1];}
+    const T& back() const noexcept {return data()[len_ - 1];}
+
+    iterator begin() noexcept {return data();}
+    iterator end() noexcept {return data() + len_;}
+    const_iterator begin() const noexcept {return data();}
+    const_iterator end() const noexcept {return data() + len_;}
+    const_iterator cbegin() const noexcept {return data();}
+    const_iterator cend() const noexcept {return data() + len_;}
+    reverse_iterator rbegin() noexcept {return reverse_iterator(end());}
+    reverse_iterator rend() noexcept {return reverse_iterator(begin());}
+    const_reverse_iterator rbegin() const noexcept {return const_reverse_iterator(end());}
+    const_reverse_iterator rend() const noexcept {return const_reverse_iterator(begin());}
+
+    template<class... Args>
+    T* try_emplace_back(Args&&... args){
+        if(len_ == N){return nullptr;}
+        ::new(static_cast<void*>(data() + len_)) T(std::forward<Args>(args)...);
+        return data() + len_++;
+    }
+    T* try_push_back(const T& value){return try_emplace_back(value);}
+    T* try_push_back(T&& value){return try_emplace_back(std::move(value));}
+    template<class... Args>
+    T& emplace_back(Args&&... args){
+        T* output = try_emplace_back(std::forward<Args>(args)...);
+        if(output == nullptr){throw std::bad_alloc();}
+        return *output;
+    }
+    void push_back(const T& value){emplace_back(value);}
+    void push_back(T&& value){emplace_back(std::move(value));}
+    void pop_back() noexcept {data()[--len_].~T();}
+
+    //removes the elements [first,last) and returns an iterator to the element after them.
+    iterator erase(const_iterator first,const_iterator last){
+        T* to = data() + (first - data());
+        T* new_end = std::move(data() + (last - data()),end(),to);
+        slice::destroy(new_end,end());
+        len_ = static_cast<size_type>(new_end - data());
+        return to;
+    }
+    iterator erase(const_iterator pos){return erase(pos,pos + 1);}
+
+    void resize(size_type new_len){
+        if(new_len > N){throw std::bad_alloc();}
+        if(new_len <= len_){slice::destroy(data() + new_len,end());len_ = new_len;return;}
+        for(;len_ < new_len;len_++){::new(static_cast<void*>(data() + len_)) T();}
+    }
+    void clear() noexcept {slice::destroy(begin(),end());len_ = 0;}
+
+private:
+    alignas(T) unsigned char storage_[N == 0 ? 1 : N*sizeof(T)];
+    size_type len_;
+};
+
+template<class T,std::size_t N>
+inline bool operator==(const fixed<T,N>& a,const fixed<T,N>& b){
+    return a.size() == b.size() && std::equal(a.begin(),a.end(),b.begin());
+}
+template<class T,std::size_t N>
+inline bool operator!=(const fixed<T,N>& a,const fixed<T,N>& b){return !(a == b);}
+
+}
+
+
+
+#endif
@@ -0,0 +1,57 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_ATOMIC
+
+
+#define CUSTOM_SLICES_ATOMIC 1
+
+/*
+This file wraps C11 atomics (<stdatomic.h>) and C++11 atomics (<atomic>) behind one set of macros,
+so the headers that need atomics (slice_concurrent.h, and slice.h with SLICE_ENABLE_STATS) work the same from C and C++.
+The memory order is given as the bare word relaxed, acquire, release, acq_rel or seq_cst.
+*/
+
+#ifdef __cplusplus
+#include <atomic>
+//an atomic object of type $type
+#define slice_atomic(type) std::atomic<type>
+#define slice_atomic_init(ptr,value) (ptr)->store(value,std::memory_order_relaxed)
+#define slice_atomic_load(ptr,order) (ptr)->load(std::memory_order_##order)
+#define slice_atomic_store(ptr,value,order) (ptr)->store(value,std::memory_order_##order)
+#define slice_atomic_fetch_add(ptr,value,order) (ptr)->fetch_add(value,std::memory_order_##order)
+#define slice_atomic_fetch_sub(ptr,value,order) (ptr)->fetch_sub(value,std::memory_order_##order)
+#define slice_atomic_compare_exchange(ptr,expected_ptr,desired,order) (ptr)->compare_exchange_strong(*(expected_ptr),desired,std::memory_order_##order)
+#else
+#include <stdatomic.h>
+//an atomic object of type $type
+#define slice_atomic(type) _Atomic(type)
+#define slice_atomic_init(ptr,value) atomic_init(ptr,value)
+#define slice_atomic_load(ptr,order) atomic_load_explicit(ptr,memory_order_##order)
+#define slice_atomic_store(ptr,value,order) atomic_store_explicit(ptr,value,memory_order_##order)
+#define slice_atomic_fetch_add(ptr,value,order) atomic_fetch_add_explicit(ptr,value,memory_order_##order)
+#define slice_atomic_fetch_sub(ptr,value,order) atomic_fetch_sub_explicit(ptr,value,memory_order_##order)
+//the order of a failed compare exchange is derived from $order like C++ does (acq_rel fails as acquire, release as relaxed),
+//so a thread that loses the race still sees the writes of the winner through the value it loaded.
+#define ___slice_atomic_failure_order_relaxed___ memory_order_relaxed
+#define ___slice_atomic_failure_order_acquire___ memory_order_acquire
+#define ___slice_atomic_failure_order_release___ memory_order_relaxed
+#define ___slice_atomic_failure_order_acq_rel___ memory_order_acquire
+#define ___slice_atomic_failure_order_seq_cst___ memory_order_seq_cst
+#define slice_atomic_compare_exchange(ptr,expected_ptr,desired,order) atomic_compare_exchange_strong_explicit(ptr,expected_ptr,desired,memory_order_##order,___slice_atomic_failure_order_##order##___)
+#endif
+
+//slice_thread_local marks a variable that every thread has its own copy of.
+#ifdef __cplusplus
+#define slice_thread_local thread_local
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define slice_thread_local _Thread_local
+#elif defined(_MSC_VER)
+#define slice_thread_local __declspec(thread)
+#else
+#define slice_thread_local __thread
+#endif
+
+
+
+#endif
@@ -0,0 +1,467 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_BITSET
+
+
+#define CUSTOM_SLICES_BITSET 1
+#include <stdint.h>
+#include "slice_simd.h"
+
+/*
+This file adds bitsets: slices of bits packed into 64 bit words, 8 times smaller than a slice of bool
+and processed a word (or a vector of words) at a time.
+
+For the remainder of this section, $name is the name of the custom type you definied.
+define_slice_bitset(name) creates the struct $name and the following functions:
+
+//$name $name_make(size_t nbits) creates a bitset of nbits bits, all clear, when done with the bitset you MUST call
+//$name_destroy on it to prevent memory leaks, $name_ok returns 0 if the allocation failed (or nbits > SIZE_MAX - 63).
+$name $name_make(size_t nbits);
+void $name_destroy($name* the_thing);
+int $name_ok($name the_thing);
+
+//size_t $name_length($name the_thing) returns the number of bits, size_t $name_cap($name the_thing) the number of bits
+//the bitset holds without growing.
+size_t $name_length($name the_thing);
+size_t $name_cap($name the_thing);
+
+//int $name_resize($name* the_thing,size_t nbits) changes the number of bits, new bits are clear.
+//int $name_append($name* the_thing,int bit) adds a bit at the end.
+//Both return 0 on failure and 1 on success.
+int $name_resize($name* the_thing,size_t nbits);
+int $name_append($name* the_thing,int bit);
+
+//int $name_test($name* the_thing,size_t i) returns 1 if bit i is set, 0 if it is clear or i is out of bounds.
+int $name_test($name* the_thing,size_t i);
+
+//int $name_set($name* the_thing,size_t i) / int $name_clear($name* the_thing,size_t i) set/clear bit i,
+//return 0 if i is out of bounds and 1 on success.
+int $name_set($name* the_thing,size_t i);
+int $name_clear($name* the_thing,size_t i);
+
+//void $name_fill($name* the_thing,int bit) sets (bit != 0) or clears (bit == 0) every bit.
+void $name_fill($name* the_thing,int bit);
+
+//size_t $name_count($name* the_thing) returns the number of set bits (popcount).
+size_t $name_count($name* the_thing);
+
+//int $name_find_first($name* the_thing,size_t from,size_t* index) looks for the first set bit at or after from,
+//returns 1 and fills index (if not NULL) if there is one, 0 otherwise. Loop with from = index + 1 to visit every set bit.
+int $name_find_first($name* the_thing,size_t from,size_t* index);
+
+//the following functions replace the contents of out with a combination of a and b, out may be a or b.
+//If a and b have different lengths the result has the larger one and the missing bits of the shorter are clear.
+//They return 0 on failure (out is left unchanged) and 1 on success.
+int $name_and($name* out,$name* a,$name* b);       a & b
+int $name_or($name* out,$name* a,$name* b);        a | b
+int $name_xor($name* out,$name* a,$name* b);       a ^ b
+int $name_andnot($name* out,$name* a,$name* b);    a & ~b
+
+Sparse bitsets can be compressed into a list of runs of set bits, the $name_rle struct, that takes 2 size_t per run
+instead of one bit per bit:
+
+//int $name_compress($name* the_thing,$name_rle* out) creates out from the bitset, returns 0 on allocation failure
+//and 1 on success. When done with out you MUST call $name_rle_destroy on it.
+int $name_compress($name* the_thing,$name_rle* out);
+
+//int $name_decompress($name_rle* rle,$name* out) replaces the contents of out with the bits of rle,
+//returns 0 on failure and 1 on success.
+int $name_decompress($name_rle* rle,$name* out);
+
+//int $name_rle_test($name_rle* rle,size_t i) returns 1 if bit i is set (binary search over the runs), 0 otherwise.
+int $name_rle_test($name_rle* rle,size_t i);
+
+//size_t $name_rle_count($name_rle* rle) returns the number of set bits.
+size_t $name_rle_count($name_rle* rle);
+
+void $name_rle_destroy($name_rle* rle);
+
+$name_and,$name_or,$name_xor and $name_andnot use the SSE2, AVX2 or AVX-512 kernels picked at runtime like
+slice_simd.h (SLICE_SIMD_MAX_LEVEL applies), $name_count uses the popcnt instruction when the cpu has it.
+*/
+
+//the number of 64 bit words holding nbits bits
+#define slice_bitset_words(nbits) (((nbits) + 63)/64)
+
+#define SLICE_BITSET_AND 0
+#define SLICE_BITSET_OR 1
+#define SLICE_BITSET_XOR 2
+#define SLICE_BITSET_ANDNOT 3
+
+//the index of the lowest set bit of w (w != 0)
+static inline unsigned slice_bitset_ctz(uint64_t w){
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctzll(w);
+#else
+    unsigned i = 0;
+    while(!(w & 1u)){w >>= 1;i++;}
+    return i;
+#endif
+}
+
+//the number of set bits of w
+static inline unsigned slice_bitset_popcount64(uint64_t w){
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ull);
+    w = (w & 0x3333333333333333ull) + ((w >> 2) & 0x3333333333333333ull);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0full;
+    return (unsigned)((w*0x0101010101010101ull) >> 56);
+#endif
+}
+
+//applies op to n words of a and b (dst may be a or b)
+static inline void slice_bitset_words_scalar(int op,uint64_t* dst,const uint64_t* a,const uint64_t* b,size_t n){
+    size_t i;
+    switch(op){
+        case SLICE_BITSET_AND: for(i = 0;i < n;i++){dst[i] = a[i] & b[i];} break;
+        case SLICE_BITSET_OR: for(i = 0;i < n;i++){dst[i] = a[i] | b[i];} break;
+        case SLICE_BITSET_XOR: for(i = 0;i < n;i++){dst[i] = a[i] ^ b[i];} break;
+        default: for(i = 0;i < n;i++){dst[i] = a[i] & ~b[i];} break;
+    }
+}
+
+static inline size_t slice_bitset_popcount_scalar(const uint64_t* words,size_t n){
+    size_t i,out = 0;
+    for(i = 0;i < n;i++){out += slice_bitset_popcount64(words[i]);}
+    return out;
+}
+
+#ifdef SLICE_SIMD_X86
+/*
+___slice_bitset_kernel___(W,TARGET,suffix) creates slice_bitset_words_$suffix working on W byte vectors compiled for TARGET,
+not meant to be used outside this file.
+*/
+#define ___slice_bitset_loop___(W,EXPR) \
+    for(;i + W/8 <= n;i += W/8){\
+        SLICE_UNSAFE_MEMCPY(&x,a + i,W);\
+        SLICE_UNSAFE_MEMCPY(&y,b + i,W);\
+        x = EXPR;\
+        SLICE_UNSAFE_MEMCPY(dst + i,&x,W);\
+    }
+#define ___slice_bitset_kernel___(W,TARGET,suffix) \
+__attribute__((target(TARGET))) static inline void slice_bitset_words_##suffix(int op,uint64_t* dst,const uint64_t* a,const uint64_t* b,size_t n){\
+    typedef unsigned long long vec __attribute__((vector_size(W)));\
+    size_t i = 0;\
+    vec x,y;\
+    switch(op){\
+        case SLICE_BITSET_AND: ___slice_bitset_loop___(W,x & y) break;\
+        case SLICE_BITSET_OR: ___slice_bitset_loop___(W,x | y) break;\
+        case SLICE_BITSET_XOR: ___slice_bitset_loop___(W,x ^ y) break;\
+        default: ___slice_bitset_loop___(W,x & ~y) break;\
+    }\
+    slice_bitset_words_scalar(op,dst + i,a + i,b + i,n - i);\
+}
+
+___slice_bitset_kernel___(16,"sse2",sse2)
+___slice_bitset_kernel___(32,"avx2",avx2)
+___slice_bitset_kernel___(64,"avx512f",avx512)
+
+//the same loop as slice_bitset_popcount_scalar, compiled to the popcnt instruction
+__attribute__((target("popcnt"))) static inline size_t slice_bitset_popcount_popcnt(const uint64_t* words,size_t n){
+    size_t i,out = 0;
+    for(i = 0;i < n;i++){out += (size_t)__builtin_popcountll(words[i]);}
+    return out;
+}
+#endif
+
+//applies op to n words of a and b (dst may be a or b) with the best kernel of this cpu
+static inline void slice_bitset_words_op(int op,uint64_t* dst,const uint64_t* a,const uint64_t* b,size_t n){
+#ifdef SLICE_SIMD_X86
+    switch(slice_simd_level()){
+        case SLICE_SIMD_AVX512: slice_bitset_words_avx512(op,dst,a,b,n); return;
+        case SLICE_SIMD_AVX2: slice_bitset_words_avx2(op,dst,a,b,n); return;
+        case SLICE_SIMD_SSE2: slice_bitset_words_sse2(op,dst,a,b,n); return;
+        default: break;
+    }
+#endif
+    slice_bitset_words_scalar(op,dst,a,b,n);
+}
+
+//returns 1 if this cpu has the popcnt instruction (and SLICE_SIMD_MAX_LEVEL allows it), only the first call queries the cpu
+static inline int slice_bitset_has_popcnt(void){
+#ifdef SLICE_SIMD_X86
+    static int cached = 0; //1 + has popcnt, 0 until the cpu was queried
+    int has = __atomic_load_n(&cached,__ATOMIC_RELAXED);
+    if(has != 0){return has - 1;}
+    has = SLICE_SIMD_MAX_LEVEL > SLICE_SIMD_SCALAR && __builtin_cpu_supports("popcnt");
+    __atomic_store_n(&cached,has + 1,__ATOMIC_RELAXED);
+    return has;
+#else
+    return 0;
+#endif
+}
+
+//returns the number of set bits of n words with the best kernel of this cpu
+static inline size_t slice_bitset_popcount(const uint64_t* words,size_t n){
+#ifdef SLICE_SIMD_X86
+    if(slice_bitset_has_popcnt()){return slice_bitset_popcount_popcnt(words,n);}
+#endif
+    return slice_bitset_popcount_scalar(words,n);
+}
+
+//returns the index of the first bit equal to bit (0 or 1) at or after from, nbits if there is none
+static inline size_t slice_bitset_next(const uint64_t* words,size_t nbits,size_t from,int bit){
+    const uint64_t flip = bit ? 0 : ~(uint64_t)0;
+    size_t i,n = slice_bitset_words(nbits),out;
+    uint64_t w;
+    if(from >= nbits){return nbits;}
+    i = from/64;
+    w = (words[i] ^ flip) & (~(uint64_t)0 << (from%64));
+    for(;;){
+        if(w){
+            out = i*64 + slice_bitset_ctz(w);
+            return out < nbits ? out : nbits;
+        }
+        if(++i >= n){return nbits;}
+        w = words[i] ^ flip;
+    }
+}
+
+//sets (bit != 0) or clears the bits start..end-1
+static inline void slice_bitset_fill_range(uint64_t* words,size_t start,size_t end,int bit){
+    size_t first = start/64,last;
+    uint64_t mask;
+    if(start >= end){return;}
+    last = (end - 1)/64;
+    for(;first <= last;first++){
+        mask = ~(uint64_t)0;
+        if(first == start/64){mask &= ~(uint64_t)0 << (start%64);}
+        if(first == last && end%64){mask &= ~(uint64_t)0 >> (64 - end%64);}
+        if(bit){words[first] |= mask;}
+        else{words[first] &= ~mask;}
+    }
+}
+
+/*
+define_slice_bitset_struct(name) creates the $name and $name_rle structs, the attributes should not be accessed
+directly unless you know what your doing. The bits of the words past the length are always clear.
+*/
+#define define_slice_bitset_struct(name) SLICE_C_BEGIN typedef struct name { uint64_t* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;} name;\
+typedef struct ___slice_function_name___(rle,name) {size_t* runs;size_t len;size_t nbits;} ___slice_function_name___(rle,name); SLICE_C_END
+
+/*
+define_slice_bitset_decl(name) creates the structs of a bitset and the declarations of its functions.
+*/
+#define define_slice_bitset_decl(name) define_slice_bitset_struct(name);\
+SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t nbits); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name the_thing); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(cap,name)(name the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t nbits); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,int bit); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(test,name)(name* the_thing,size_t i); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set,name)(name* the_thing,size_t i); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(clear,name)(name* the_thing,size_t i); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(fill,name)(name* the_thing,int bit); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(count,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(find_first,name)(name* the_thing,size_t from,size_t* index); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(and,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(or,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(xor,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(andnot,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(compress,name)(name* the_thing,___slice_function_name___(rle,name)* out); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(decompress,name)(___slice_function_name___(rle,name)* rle,name* out); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(rle_test,name)(___slice_function_name___(rle,name)* rle,size_t i); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(rle_count,name)(___slice_function_name___(rle,name)* rle); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(rle_destroy,name)(___slice_function_name___(rle,name)* rle); SLICE_C_END
+
+/*
+define_slice_bitset_definitions(name) creates the function definitions of a bitset.
+define_slice_bitset_decl MUST be used prior to this with the same name.
+*/
+#define define_slice_bitset_definitions(name) \
+static int ___slice_function_name___(bitset_reserve,name)(name* the_thing,size_t words){\
+    uint64_t* grown;\
+    size_t new_cap;\
+    if(words <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    new_cap = SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),words,sizeof(uint64_t));\
+    if(new_cap < words){new_cap = words;}\
+    if(new_cap > slice_max_cap(uint64_t)){return 0;}\
+    grown = slice_realloc(uint64_t,slice_unsafe_raw_storage_ptr(the_thing),new_cap);\
+    if(slice_alloc_failed(grown)){return 0;}\
+    SLICE_UNSAFE_MEMSET(grown + slice_unsafe_raw_cap(the_thing),0,(new_cap - slice_unsafe_raw_cap(the_thing))*sizeof(uint64_t));\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+}\
+static int ___slice_function_name___(bitset_combine,name)(int op,name* out,name* a,name* b){\
+    size_t na,nb,n,common,len;\
+    name* longer;\
+    if(out == NULL||a == NULL||b == NULL||slice_unsafe_raw_storage_ptr(out) == NULL||\
+        slice_unsafe_raw_storage_ptr(a) == NULL||slice_unsafe_raw_storage_ptr(b) == NULL){return 0;}\
+    na = slice_bitset_words(slice_unsafe_raw_len(a));\
+    nb = slice_bitset_words(slice_unsafe_raw_len(b));\
+    len = slice_unsafe_raw_len(a) > slice_unsafe_raw_len(b) ? slice_unsafe_raw_len(a) : slice_unsafe_raw_len(b);\
+    n = slice_bitset_words(len);\
+    common = na < nb ? na : nb;\
+    longer = na > nb ? a : b;\
+    if(slice_grow_failed(___slice_function_name___(bitset_reserve,name)(out,n))){return 0;}\
+    slice_bitset_words_op(op,slice_unsafe_raw_storage_ptr(out),slice_unsafe_raw_storage_ptr(a),slice_unsafe_raw_storage_ptr(b),common);\
+    if(op == SLICE_BITSET_AND||(op == SLICE_BITSET_ANDNOT && longer != a)){\
+        SLICE_UNSAFE_MEMSET(slice_unsafe_raw_storage_ptr(out) + common,0,(n - common)*sizeof(uint64_t));\
+    }\
+    else{\
+        slice_memmove(uint64_t,slice_unsafe_raw_storage_ptr(out) + common,slice_unsafe_raw_storage_ptr(longer) + common,n - common);\
+    }\
+    if(slice_unsafe_raw_len(out) > len){\
+        SLICE_UNSAFE_MEMSET(slice_unsafe_raw_storage_ptr(out) + n,0,(slice_bitset_words(slice_unsafe_raw_len(out)) - n)*sizeof(uint64_t));\
+    }\
+    slice_unsafe_raw_len(out) = len;\
+    return 1;\
+}\
+SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t nbits){\
+    name output = {NULL,nbits,0};\
+    if(nbits > ((size_t)-1) - 63){slice_unsafe_value_len(output) = 0;return output;}\
+    slice_unsafe_value_cap(output) = slice_bitset_words(nbits);\
+    if(slice_unsafe_value_cap(output) == 0){slice_unsafe_value_cap(output) = 1;}\
+    slice_unsafe_value_storage_ptr(output) = slice_calloc(uint64_t,slice_unsafe_value_cap(output));\
+    if(slice_alloc_failed(slice_unsafe_value_storage_ptr(output))){slice_unsafe_value_len(output) = 0;slice_unsafe_value_cap(output) = 0;}\
+    return output;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_free(slice_unsafe_raw_storage_ptr(the_thing));}\
+    slice_unsafe_raw_storage_ptr(the_thing) = NULL;\
+    slice_unsafe_raw_len(the_thing) = 0;\
+    slice_unsafe_raw_cap(the_thing) = 0;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing){\
+    return slice_unsafe_value_storage_ptr(the_thing) != NULL;\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name the_thing){\
+    return slice_unsafe_value_len(the_thing);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(cap,name)(name the_thing){\
+    return slice_unsafe_value_cap(the_thing)*64;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t nbits){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(nbits < slice_unsafe_raw_len(the_thing)){\
+        slice_bitset_fill_range(slice_unsafe_raw_storage_ptr(the_thing),nbits,slice_unsafe_raw_len(the_thing),0);\
+    }\
+    else if(nbits > ((size_t)-1) - 63||slice_grow_failed(___slice_function_name___(bitset_reserve,name)(the_thing,slice_bitset_words(nbits)))){return 0;}\
+    slice_unsafe_raw_len(the_thing) = nbits;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,int bit){\
+    size_t i;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    i = slice_unsafe_raw_len(the_thing);\
+    if(i >= ((size_t)-1) - 63||slice_grow_failed(___slice_function_name___(bitset_reserve,name)(the_thing,slice_bitset_words(i + 1)))){return 0;}\
+    if(bit){slice_unsafe_raw_storage_ptr(the_thing)[i/64] |= (uint64_t)1 << (i%64);}\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(test,name)(name* the_thing,size_t i){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||i >= slice_unsafe_raw_len(the_thing)){return 0;}\
+    return (int)((slice_unsafe_raw_storage_ptr(the_thing)[i/64] >> (i%64)) & 1u);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set,name)(name* the_thing,size_t i){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||i >= slice_unsafe_raw_len(the_thing)){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing)[i/64] |= (uint64_t)1 << (i%64);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(clear,name)(name* the_thing,size_t i){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||i >= slice_unsafe_raw_len(the_thing)){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing)[i/64] &= ~((uint64_t)1 << (i%64));\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(fill,name)(name* the_thing,int bit){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return;}\
+    slice_bitset_fill_range(slice_unsafe_raw_storage_ptr(the_thing),0,slice_unsafe_raw_len(the_thing),bit);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(count,name)(name* the_thing){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    return slice_bitset_popcount(slice_unsafe_raw_storage_ptr(the_thing),slice_bitset_words(slice_unsafe_raw_len(the_thing)));\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(find_first,name)(name* the_thing,size_t from,size_t* index){\
+    size_t i;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    i = slice_bitset_next(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),from,1);\
+    if(i == slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(index != NULL){*index = i;}\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(and,name)(name* out,name* a,name* b){\
+    return ___slice_function_name___(bitset_combine,name)(SLICE_BITSET_AND,out,a,b);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(or,name)(name* out,name* a,name* b){\
+    return ___slice_function_name___(bitset_combine,name)(SLICE_BITSET_OR,out,a,b);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(xor,name)(name* out,name* a,name* b){\
+    return ___slice_function_name___(bitset_combine,name)(SLICE_BITSET_XOR,out,a,b);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(andnot,name)(name* out,name* a,name* b){\
+    return ___slice_function_name___(bitset_combine,name)(SLICE_BITSET_ANDNOT,out,a,b);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(compress,name)(name* the_thing,___slice_function_name___(rle,name)* out){\
+    const uint64_t* words;\
+    size_t nbits,start,end = 0,runs = 0;\
+    if(the_thing == NULL||out == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    words = slice_unsafe_raw_storage_ptr(the_thing);\
+    nbits = slice_unsafe_raw_len(the_thing);\
+    for(start = slice_bitset_next(words,nbits,0,1);start < nbits;start = slice_bitset_next(words,nbits,end,1)){\
+        end = slice_bitset_next(words,nbits,start,0);\
+        runs++;\
+    }\
+    out->runs = slice_calloc(size_t,runs ? 2*runs : 1);\
+    if(slice_alloc_failed(out->runs)){out->len = 0;out->nbits = 0;return 0;}\
+    out->len = runs;\
+    out->nbits = nbits;\
+    runs = 0;\
+    for(start = slice_bitset_next(words,nbits,0,1);start < nbits;start = slice_bitset_next(words,nbits,end,1)){\
+        end = slice_bitset_next(words,nbits,start,0);\
+        out->runs[2*runs] = start;\
+        out->runs[2*runs + 1] = end;\
+        runs++;\
+    }\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(decompress,name)(___slice_function_name___(rle,name)* rle,name* out){\
+    size_t i;\
+    if(rle == NULL||rle->runs == NULL||out == NULL||slice_unsafe_raw_storage_ptr(out) == NULL){return 0;}\
+    if(slice_grow_failed(___slice_function_name___(bitset_reserve,name)(out,slice_bitset_words(rle->nbits)))){return 0;}\
+    slice_bitset_fill_range(slice_unsafe_raw_storage_ptr(out),0,slice_unsafe_raw_len(out),0);\
+    slice_unsafe_raw_len(out) = rle->nbits;\
+    for(i = 0;i < rle->len;i++){\
+        slice_bitset_fill_range(slice_unsafe_raw_storage_ptr(out),rle->runs[2*i],rle->runs[2*i + 1],1);\
+    }\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(rle_test,name)(___slice_function_name___(rle,name)* rle,size_t i){\
+    size_t lo = 0,hi,mid;\
+    if(rle == NULL||rle->runs == NULL){return 0;}\
+    hi = rle->len;\
+    while(lo < hi){\
+        mid = lo + (hi - lo)/2;\
+        if(rle->runs[2*mid] <= i){lo = mid + 1;}\
+        else{hi = mid;}\
+    }\
+    return lo > 0 && i < rle->runs[2*(lo - 1) + 1];\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(rle_count,name)(___slice_function_name___(rle,name)* rle){\
+    size_t i,out = 0;\
+    if(rle == NULL||rle->runs == NULL){return 0;}\
+    for(i = 0;i < rle->len;i++){out += rle->runs[2*i + 1] - rle->runs[2*i];}\
+    return out;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(rle_destroy,name)(___slice_function_name___(rle,name)* rle){\
+    if(rle == NULL){return;}\
+    if(rle->runs != NULL){slice_free(rle->runs);}\
+    rle->runs = NULL;\
+    rle->len = 0;\
+    rle->nbits = 0;\
+} SLICE_C_END
+
+/*
+define_slice_bitset(name) creates a bitset named $name as described at the top of this file.
+*/
+#define define_slice_bitset(name) define_slice_bitset_decl(name);define_slice_bitset_definitions(name)
+
+
+
+#endif
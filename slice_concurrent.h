@@ -0,0 +1,773 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_CONCURRENT
+
+
+#define CUSTOM_SLICES_CONCURRENT 1
+#include <stddef.h>
+#include "slice.h"
+#include "slice_atomic.h"
+
+/*
+This file adds slices that may be shared between threads, it requires C11 atomics (<stdatomic.h>)
+or C++11 atomics (<atomic>) when compiled as C++.
+
+For the remainder of this section, $name is the name of the custom type you definied, and $type
+is the type of an individual element in the container.
+Unlike regular slices, concurrent slices hold atomics and MUST NOT be copied,
+so they are initialized in place with $name_init(&slice,...) instead of being returned by $name_make,
+and their accessor functions take a pointer to the slice.
+*/
+
+//rounds x up to a power of 2 (x > 0)
+static inline size_t slice_round_pow2(size_t x){
+    size_t out = 1;
+    while(out < x){out <<= 1;}
+    return out;
+}
+
+
+/*
+Single producer/single consumer slices.
+A spsc slice is a bounded ring buffer that one thread pushes to and another thread pops from without locks.
+The producer index (tail) and the consumer index (head) live on different cache lines,
+and each side keeps a cached copy of the other side's index so it only reads the shared index
+when the ring looks full (producer) or empty (consumer).
+The capacity is rounded up to a power of 2.
+*/
+
+/*
+define_slice_spsc_struct creates a struct to act as a spsc slice type to hold objects of type $type.
+the attributes should not be accessed directly unless you know what your doing,
+instead accessor functions are defined in this header that allow you to modify the slice
+*/
+#define define_slice_spsc_struct(name,type) SLICE_C_BEGIN typedef struct name {\
+    type* SLICE_DATA_VARAIABLE_NAME;\
+    size_t SLICE_CAPACITY_VARAIABLE_NAME;\
+    char ___pad0___[SLICE_CACHE_LINE_SIZE];\
+    slice_atomic(size_t) SLICE_HEAD_VARAIABLE_NAME;\
+    size_t cached_tail;\
+    char ___pad1___[SLICE_CACHE_LINE_SIZE];\
+    slice_atomic(size_t) tail;\
+    size_t cached_head;\
+    char ___pad2___[SLICE_CACHE_LINE_SIZE];\
+} name; SLICE_C_END
+
+/*
+int $name_init($name* the_thing,size_t cap) initializes a spsc slice that holds up to cap elements (rounded up to a power of 2),
+returns 1 on success and 0 on error, when done with the slice you MUST call $name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_spsc_init(name,type) SLICE_C_BEGIN int ___slice_function_name___(init,name)(name* the_thing,size_t cap){\
+    if(the_thing == NULL){return 0;}\
+    if(cap == 0){cap = 10;}\
+    if(cap > slice_max_cap(type)/2){return 0;}\
+    cap = slice_round_pow2(cap);\
+    slice_unsafe_raw_storage_ptr(the_thing) = slice_calloc(type,cap);\
+    slice_unsafe_raw_cap(the_thing) = slice_alloc_failed(slice_unsafe_raw_storage_ptr(the_thing)) ? 0 : cap;\
+    slice_atomic_init(&slice_unsafe_raw_head(the_thing),0);\
+    slice_atomic_init(&the_thing->tail,0);\
+    the_thing->cached_head = 0;\
+    the_thing->cached_tail = 0;\
+    return slice_unsafe_raw_cap(the_thing) != 0;\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys a spsc slice, this MUST be called when the slice is done being used
+and no thread uses it anymore, it MUST NOT be used after this function is called;
+*/
+#define define_slice_spsc_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_free(slice_unsafe_raw_storage_ptr(the_thing));}\
+    slice_unsafe_raw_storage_ptr(the_thing) = NULL;\
+    slice_unsafe_raw_cap(the_thing) = 0;\
+} SLICE_C_END
+
+/*
+size_t $name_try_push_n($name* the_thing,const type* src,size_t n) pushes up to n items from src, may only be called by the producer thread,
+returns the number of items pushed (less than n if the slice is full), they are published to the consumer at once.
+*/
+#define define_slice_spsc_try_push_n(name,type) SLICE_C_BEGIN size_t ___slice_function_name___(try_push_n,name)(name* the_thing,const type* src,size_t n){\
+    size_t cap = slice_unsafe_raw_cap(the_thing);\
+    size_t tail = slice_atomic_load(&the_thing->tail,relaxed);\
+    size_t room = cap - (tail - the_thing->cached_head);\
+    size_t at,first;\
+    if(room < n){\
+        the_thing->cached_head = slice_atomic_load(&slice_unsafe_raw_head(the_thing),acquire);\
+        room = cap - (tail - the_thing->cached_head);\
+    }\
+    if(n > room){n = room;}\
+    if(n == 0){return 0;}\
+    at = tail & (cap - 1);\
+    first = cap - at < n ? cap - at : n;\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing) + at,src,first);\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing),src + first,n - first);\
+    slice_atomic_store(&the_thing->tail,tail + n,release);\
+    return n;\
+} SLICE_C_END
+
+/*
+size_t $name_try_pop_n($name* the_thing,type* dst,size_t n) pops up to n items into dst, may only be called by the consumer thread,
+returns the number of items popped (less than n if the slice does not hold n items).
+*/
+#define define_slice_spsc_try_pop_n(name,type) SLICE_C_BEGIN size_t ___slice_function_name___(try_pop_n,name)(name* the_thing,type* dst,size_t n){\
+    size_t cap = slice_unsafe_raw_cap(the_thing);\
+    size_t head = slice_atomic_load(&slice_unsafe_raw_head(the_thing),relaxed);\
+    size_t ready = the_thing->cached_tail - head;\
+    size_t at,first;\
+    if(ready < n){\
+        the_thing->cached_tail = slice_atomic_load(&the_thing->tail,acquire);\
+        ready = the_thing->cached_tail - head;\
+    }\
+    if(n > ready){n = ready;}\
+    if(n == 0){return 0;}\
+    at = head & (cap - 1);\
+    first = cap - at < n ? cap - at : n;\
+    slice_memcpy(type,dst,slice_unsafe_raw_storage_ptr(the_thing) + at,first);\
+    slice_memcpy(type,dst + first,slice_unsafe_raw_storage_ptr(the_thing),n - first);\
+    slice_atomic_store(&slice_unsafe_raw_head(the_thing),head + n,release);\
+    return n;\
+} SLICE_C_END
+
+/*
+int $name_try_push($name* the_thing,type arg) pushes an item, may only be called by the producer thread,
+returns 1 on success and 0 if the slice is full.
+*/
+#define define_slice_spsc_try_push(name,type) SLICE_C_BEGIN int ___slice_function_name___(try_push,name)(name* the_thing,type arg){\
+    return ___slice_function_name___(try_push_n,name)(the_thing,&arg,1) == 1;\
+} SLICE_C_END
+
+/*
+int $name_try_pop($name* the_thing,type* result) pops an item into result, may only be called by the consumer thread,
+returns 1 on success and 0 if the slice is empty.
+*/
+#define define_slice_spsc_try_pop(name,type) SLICE_C_BEGIN int ___slice_function_name___(try_pop,name)(name* the_thing,type* result){\
+    return ___slice_function_name___(try_pop_n,name)(the_thing,result,1) == 1;\
+} SLICE_C_END
+
+/*
+size_t $name_length(name* the_thing) returns the number of items in a spsc slice,
+the value may be out of date by the time it is returned if the other thread is active.
+*/
+#define define_slice_spsc_length(name,type) SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name* the_thing){\
+    size_t head = slice_atomic_load(&slice_unsafe_raw_head(the_thing),acquire);\
+    return slice_atomic_load(&the_thing->tail,acquire) - head;\
+} SLICE_C_END
+
+/*
+size_t $name_cap(name* the_thing) returns the capacity of a spsc slice.
+*/
+#define define_slice_spsc_cap(name,type) SLICE_C_BEGIN size_t ___slice_function_name___(cap,name)(name* the_thing){\
+    return slice_unsafe_raw_cap(the_thing);\
+} SLICE_C_END
+
+/*
+define_slice_spsc_all_funct_decl(name,type) creates all the function declarations needed to create a spsc slice.
+*/
+#define define_slice_spsc_all_funct_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(init,name)(name* the_thing,size_t cap); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(try_push_n,name)(name* the_thing,const type* src,size_t n); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(try_pop_n,name)(name* the_thing,type* dst,size_t n); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(try_push,name)(name* the_thing,type arg); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(try_pop,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(cap,name)(name* the_thing); SLICE_C_END
+
+/*
+define_slice_spsc_declarations(name,type) creates a spsc slice named $name to pass objects of type $type between two threads.
+It will create a struct declaration and all function declarations to
+provide a means to utilize the struct
+*/
+#define define_slice_spsc_declarations(name,type) define_slice_spsc_struct(name,type);define_slice_spsc_all_funct_decl(name,type)
+
+/*
+define_slice_spsc_definitions(name,type) creates all the function definitions to use a spsc slice.
+define_slice_spsc_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_spsc_struct).
+*/
+#define define_slice_spsc_definitions(name,type) define_slice_spsc_init(name,type);\
+define_slice_spsc_destroy(name,type);\
+define_slice_spsc_try_push_n(name,type);\
+define_slice_spsc_try_pop_n(name,type);\
+define_slice_spsc_try_push(name,type);\
+define_slice_spsc_try_pop(name,type);\
+define_slice_spsc_length(name,type);\
+define_slice_spsc_cap(name,type);
+
+/*
+define_slice_spsc(name,type) creates a spsc slice named $name, a lock free bounded ring buffer
+to pass objects of type $type from one producer thread to one consumer thread.
+It will create a struct declaration and function declarations to
+provide a means to utilize the struct.
+It will also define all the functions,
+so if you wish to seperate the functions from
+the declearations you may use
+define_slice_spsc_declarations(name,type) and define_slice_spsc_definitions(name,type).
+It will create the following functions:
+
+//int $name_init($name* the_thing,size_t cap) initializes a spsc slice that holds up to cap elements (rounded up to a power of 2),
+//returns 1 on success and 0 on error, when done with the slice you MUST call $name_destroy on it to prevent memory leaks.
+int $name_init($name* the_thing,size_t cap);
+
+//void $name_destroy(name* the_thing) destroys a spsc slice once no thread uses it anymore.
+void $name_destroy(name* the_thing);
+
+//size_t $name_try_push_n($name* the_thing,const type* src,size_t n) pushes up to n items from src (producer only),
+//returns the number of items pushed.
+size_t $name_try_push_n($name* the_thing,const type* src,size_t n);
+
+//size_t $name_try_pop_n($name* the_thing,type* dst,size_t n) pops up to n items into dst (consumer only),
+//returns the number of items popped.
+size_t $name_try_pop_n($name* the_thing,type* dst,size_t n);
+
+//int $name_try_push($name* the_thing,type arg) pushes an item (producer only), returns 1 on success and 0 if the slice is full.
+int $name_try_push($name* the_thing,type arg);
+
+//int $name_try_pop($name* the_thing,type* result) pops an item (consumer only), returns 1 on success and 0 if the slice is empty.
+int $name_try_pop($name* the_thing,type* result);
+
+//size_t $name_length(name* the_thing) returns the number of items in the slice.
+size_t $name_length(name* the_thing);
+
+//size_t $name_cap(name* the_thing) returns the capacity of the slice.
+size_t $name_cap(name* the_thing);
+*/
+#define define_slice_spsc(name,type) define_slice_spsc_declarations(name,type);define_slice_spsc_definitions(name,type)
+
+
+
+/*
+Concurrent append slices.
+A concurrent slice may be appended to by many threads at once without a lock.
+Each append reserves its slot with one atomic fetch add on the length, so appending threads never wait for each other.
+Elements are stored in segments that are never moved, segment k holds SLICE_CONCURRENT_FIRST_SEGMENT << k elements,
+so growing never copies and a pointer to an element stays valid until the slice is destroyed.
+A new segment is allocated by the first thread that needs it and installed with a compare exchange.
+Every slot has a ready flag that is set (with release semantics) once its element is written,
+$name_bounded_at only reads elements whose flag is set, so readers never see a torn element.
+*/
+#ifndef SLICE_CONCURRENT_FIRST_SEGMENT
+//the number of elements in the first segment of a concurrent slice, must be a power of 2
+#define SLICE_CONCURRENT_FIRST_SEGMENT 64
+#endif
+
+//the number of segments of a concurrent slice, enough to hold any size_t index
+#define SLICE_CONCURRENT_SEGMENTS (sizeof(size_t)*8)
+
+//returns the index of the highest set bit of x (x > 0)
+static inline size_t slice_floor_log2(size_t x){
+#if defined(__GNUC__) || defined(__clang__)
+    return (sizeof(unsigned long long)*8 - 1) - (size_t)__builtin_clzll((unsigned long long)x);
+#else
+    size_t out = 0;
+    while(x >>= 1){out++;}
+    return out;
+#endif
+}
+
+//the segment holding element index of a concurrent slice
+#define slice_concurrent_segment(index) slice_floor_log2((index)/SLICE_CONCURRENT_FIRST_SEGMENT + 1)
+//the number of elements in segment k of a concurrent slice
+#define slice_concurrent_segment_size(k) ((size_t)SLICE_CONCURRENT_FIRST_SEGMENT << (k))
+//the offset of element index in its segment k of a concurrent slice
+#define slice_concurrent_offset(index,k) ((index) - (slice_concurrent_segment_size(k) - SLICE_CONCURRENT_FIRST_SEGMENT))
+//the ready flags of segment k (they are stored after the elements)
+#define slice_concurrent_flags(type,segment,k) ((slice_atomic(unsigned char)*)((segment) + slice_concurrent_segment_size(k)))
+
+/*
+define_slice_concurrent_struct creates a struct to act as a concurrent slice type to hold objects of type $type.
+the attributes should not be accessed directly unless you know what your doing,
+instead accessor functions are defined in this header that allow you to modify the slice
+*/
+#define define_slice_concurrent_struct(name,type) SLICE_C_BEGIN typedef struct name {\
+    slice_atomic(size_t) SLICE_LENGTH_VARAIABLE_NAME;\
+    char ___pad0___[SLICE_CACHE_LINE_SIZE];\
+    slice_atomic(type*) segments[SLICE_CONCURRENT_SEGMENTS];\
+} name; SLICE_C_END
+
+/*
+int $name_init($name* the_thing) initializes an empty concurrent slice, no memory is allocated until the first append,
+returns 1 on success and 0 on error, when done with the slice you MUST call $name_destroy on it to prevent memory leaks.
+*/
+#define define_slice_concurrent_init(name,type) SLICE_C_BEGIN int ___slice_function_name___(init,name)(name* the_thing){\
+    size_t k;\
+    if(the_thing == NULL){return 0;}\
+    slice_atomic_init(&slice_unsafe_raw_len(the_thing),0);\
+    for(k = 0;k < SLICE_CONCURRENT_SEGMENTS;k++){slice_atomic_init(&the_thing->segments[k],(type*)NULL);}\
+    return 1;\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys a concurrent slice, this MUST be called when the slice is done being used
+and no thread uses it anymore, it MUST NOT be used after this function is called;
+*/
+#define define_slice_concurrent_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    size_t k;\
+    type* segment;\
+    if(the_thing == NULL){return;}\
+    for(k = 0;k < SLICE_CONCURRENT_SEGMENTS;k++){\
+        segment = slice_atomic_load(&the_thing->segments[k],acquire);\
+        if(segment != NULL){slice_free(segment);}\
+        slice_atomic_store(&the_thing->segments[k],(type*)NULL,relaxed);\
+    }\
+    slice_atomic_store(&slice_unsafe_raw_len(the_thing),0,relaxed);\
+} SLICE_C_END
+
+/*
+type* $name_segment($name* the_thing,size_t k) returns segment k of a concurrent slice, allocating it if needed,
+returns NULL if the allocation failed. Not meant to be used outside this file.
+*/
+#define define_slice_concurrent_segment(name,type) SLICE_C_BEGIN type* ___slice_function_name___(segment,name)(name* the_thing,size_t k){\
+    type* segment = slice_atomic_load(&the_thing->segments[k],acquire);\
+    type* expected = NULL;\
+    if(segment != NULL){return segment;}\
+    if(slice_concurrent_segment_size(k) > slice_max_cap(type)/2){return NULL;}\
+    segment = (type*)SLICE_UNSAFE_CALLOC_ALLOCATOR(1,slice_concurrent_segment_size(k)*(sizeof(type) + 1));\
+    if(slice_alloc_failed(segment)){return NULL;}\
+    if(slice_atomic_compare_exchange(&the_thing->segments[k],&expected,segment,acq_rel)){return segment;}\
+    slice_free(segment);\
+    return expected;\
+} SLICE_C_END
+
+/*
+int $name_append_n($name* the_thing,const type* src,size_t n) appends n items from src to a concurrent slice,
+may be called by any number of threads at once, the n items are stored next to each other,
+returns 1 on success and 0 on error (the reserved slots then stay unreadable).
+*/
+#define define_slice_concurrent_append_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n){\
+    size_t index,k,offset,count,i;\
+    type* segment;\
+    if(the_thing == NULL||(src == NULL && n != 0)){return 0;}\
+    if(n == 0){return 1;}\
+    index = slice_atomic_fetch_add(&slice_unsafe_raw_len(the_thing),n,relaxed);\
+    while(n != 0){\
+        k = slice_concurrent_segment(index);\
+        offset = slice_concurrent_offset(index,k);\
+        segment = ___slice_function_name___(segment,name)(the_thing,k);\
+        if(segment == NULL){return 0;}\
+        count = slice_concurrent_segment_size(k) - offset;\
+        if(count > n){count = n;}\
+        slice_memcpy(type,segment + offset,src,count);\
+        for(i = 0;i < count;i++){slice_atomic_store(&slice_concurrent_flags(type,segment,k)[offset + i],1,release);}\
+        index += count;src += count;n -= count;\
+    }\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append($name* the_thing,type arg) appends an item to a concurrent slice,
+may be called by any number of threads at once, returns 1 on success and 0 on error.
+*/
+#define define_slice_concurrent_append(name,type) SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,type arg){\
+    size_t index,k,offset;\
+    type* segment;\
+    if(the_thing == NULL){return 0;}\
+    index = slice_atomic_fetch_add(&slice_unsafe_raw_len(the_thing),1,relaxed);\
+    k = slice_concurrent_segment(index);\
+    offset = slice_concurrent_offset(index,k);\
+    segment = ___slice_function_name___(segment,name)(the_thing,k);\
+    if(segment == NULL){return 0;}\
+    segment[offset] = arg;\
+    slice_atomic_store(&slice_concurrent_flags(type,segment,k)[offset],1,release);\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_bounded_at($name* the_thing,size_t index,type* result) gets the value of a concurrent slice at index 'index' into result,
+returns 1 on success and 0 if index is out of bounds or the element at index has not been written yet.
+may be called while other threads append.
+*/
+#define define_slice_concurrent_bounded_at(name,type) SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,type* result){\
+    size_t k,offset;\
+    type* segment;\
+    if(the_thing == NULL||result == NULL||index >= slice_atomic_load(&slice_unsafe_raw_len(the_thing),relaxed)){return 0;}\
+    k = slice_concurrent_segment(index);\
+    offset = slice_concurrent_offset(index,k);\
+    segment = slice_atomic_load(&the_thing->segments[k],acquire);\
+    if(segment == NULL||!slice_atomic_load(&slice_concurrent_flags(type,segment,k)[offset],acquire)){return 0;}\
+    *result = segment[offset];\
+    return 1;\
+} SLICE_C_END
+
+/*
+type* $name_at_ptr($name* the_thing,size_t index) returns a pointer to the element at index 'index' of a concurrent slice,
+this function should only be called if you know the element has been appended and published to this thread (for example after
+joining the appending threads), the pointer stays valid until the slice is destroyed.
+*/
+#define define_slice_concurrent_at_ptr(name,type) SLICE_C_BEGIN type* ___slice_function_name___(at_ptr,name)(name* the_thing,size_t index){\
+    size_t k = slice_concurrent_segment(index);\
+    return slice_atomic_load(&the_thing->segments[k],acquire) + slice_concurrent_offset(index,k);\
+} SLICE_C_END
+
+/*
+$type $name_at($name* the_thing,size_t index) returns the value at an index of a concurrent slice,
+this function should only be called if you know the element has been appended and published to this thread,
+if you dont know you may use the $name_bounded_at function
+*/
+#define define_slice_concurrent_at(name,type) SLICE_C_BEGIN type ___slice_function_name___(at,name)(name* the_thing,size_t index){\
+    return *___slice_function_name___(at_ptr,name)(the_thing,index);\
+} SLICE_C_END
+
+/*
+size_t $name_length($name* the_thing) returns the number of slots reserved in a concurrent slice,
+slots reserved by appends that are still running are counted but can not be read yet.
+*/
+#define define_slice_concurrent_length(name,type) SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name* the_thing){\
+    return slice_atomic_load(&slice_unsafe_raw_len(the_thing),acquire);\
+} SLICE_C_END
+
+/*
+define_slice_concurrent_all_funct_decl(name,type) creates all the function declarations needed to create a concurrent slice.
+*/
+#define define_slice_concurrent_all_funct_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(init,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN type* ___slice_function_name___(segment,name)(name* the_thing,size_t k); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,type arg); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,type* result); SLICE_C_END;\
+SLICE_C_BEGIN type* ___slice_function_name___(at_ptr,name)(name* the_thing,size_t index); SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(at,name)(name* the_thing,size_t index); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name* the_thing); SLICE_C_END
+
+/*
+define_slice_concurrent_declarations(name,type) creates a concurrent slice named $name that many threads may append objects of type $type to.
+It will create a struct declaration and all function declarations to
+provide a means to utilize the struct
+*/
+#define define_slice_concurrent_declarations(name,type) define_slice_concurrent_struct(name,type);define_slice_concurrent_all_funct_decl(name,type)
+
+/*
+define_slice_concurrent_definitions(name,type) creates all the function definitions to use a concurrent slice.
+define_slice_concurrent_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_concurrent_struct).
+*/
+#define define_slice_concurrent_definitions(name,type) define_slice_concurrent_init(name,type);\
+define_slice_concurrent_destroy(name,type);\
+define_slice_concurrent_segment(name,type);\
+define_slice_concurrent_append_n(name,type);\
+define_slice_concurrent_append(name,type);\
+define_slice_concurrent_bounded_at(name,type);\
+define_slice_concurrent_at_ptr(name,type);\
+define_slice_concurrent_at(name,type);\
+define_slice_concurrent_length(name,type);
+
+/*
+define_slice_concurrent(name,type) creates a concurrent slice named $name that many threads may append objects of type $type to at once.
+It will create a struct declaration and function declarations to
+provide a means to utilize the struct.
+It will also define all the functions,
+so if you wish to seperate the functions from
+the declearations you may use
+define_slice_concurrent_declarations(name,type) and define_slice_concurrent_definitions(name,type).
+It will create the following functions:
+
+//int $name_init($name* the_thing) initializes an empty concurrent slice,
+//when done with the slice you MUST call $name_destroy on it to prevent memory leaks.
+int $name_init($name* the_thing);
+
+//void $name_destroy(name* the_thing) destroys a concurrent slice once no thread uses it anymore.
+void $name_destroy(name* the_thing);
+
+//int $name_append($name* the_thing,type arg) appends an item (any thread), returns 1 on success and 0 on error.
+int $name_append($name* the_thing,type arg);
+
+//int $name_append_n($name* the_thing,const type* src,size_t n) appends n items next to each other (any thread),
+//returns 1 on success and 0 on error.
+int $name_append_n($name* the_thing,const type* src,size_t n);
+
+//int $name_bounded_at($name* the_thing,size_t index,type* result) gets the value at index 'index' into result,
+//returns 0 if index is out of bounds or the element has not been written yet.
+int $name_bounded_at($name* the_thing,size_t index,type* result);
+
+//$type $name_at($name* the_thing,size_t index) and type* $name_at_ptr($name* the_thing,size_t index) access an element
+//that is known to be published, pointers stay valid until the slice is destroyed.
+$type $name_at($name* the_thing,size_t index);
+type* $name_at_ptr($name* the_thing,size_t index);
+
+//size_t $name_length($name* the_thing) returns the number of reserved slots.
+size_t $name_length($name* the_thing);
+*/
+#define define_slice_concurrent(name,type) define_slice_concurrent_declarations(name,type);define_slice_concurrent_definitions(name,type)
+
+/*
+Copy on write slices.
+A cow slice has the same fields as a regular slice, but its elements are preceded by a header holding an atomic
+reference count so several handles may share one buffer: $name_clone makes another handle to the same buffer in O(1)
+and $name_destroy only frees the buffer when the last handle to it is destroyed.
+The first call that writes through a handle whose buffer is shared ($name_append,$name_append_n,$name_set,$name_bounded_set,
+$name_resize,$name_reserve,$name_grow or $name_detach) copies the elements into a buffer of its own first,
+so writes through one handle are never seen through another one.
+$name_pop only shortens the handle it is called on and never copies.
+Different handles to one buffer may be used, cloned and destroyed by different threads at once,
+a single handle MUST NOT be used by two threads at once (clone it and give each thread its own handle).
+*/
+
+#ifndef SLICE_COW_HEADER_SIZE
+//the smallest number of bytes in front of the elements of a cow slice that hold the reference count,
+//it MUST be a power of two no smaller than sizeof(size_t).
+#define SLICE_COW_HEADER_SIZE 16
+#endif
+
+//the alignment of the elements of the cow slice $name of $type,
+//C99 reads it from the $name_cow_align struct made by define_slice_cow_declarations.
+#ifdef __cplusplus
+#define slice_cow_alignof(name,type) alignof(type)
+#elif defined(__STDC_VERSION__) && __STDC_VERSION__ >= 201112L
+#define slice_cow_alignof(name,type) _Alignof(type)
+#else
+#define slice_cow_alignof(name,type) offsetof(___slice_function_name___(cow_align,name),t)
+#endif
+
+//the bytes in front of the elements of the cow slice $name of $type, SLICE_COW_HEADER_SIZE rounded up to the alignment of $type.
+//the buffer comes from SLICE_UNSAFE_CALLOC_ALLOCATOR/SLICE_UNSAFE_REALLOC_ALLOCATOR, which only align it for max_align_t,
+//so like every other slice a cow slice doesn't support types aligned beyond max_align_t.
+#define slice_cow_header_size(name,type) (slice_cow_alignof(name,type) > SLICE_COW_HEADER_SIZE ? (size_t)slice_cow_alignof(name,type) : (size_t)SLICE_COW_HEADER_SIZE)
+
+//the reference count of the cow buffer whose elements start at data, header is its slice_cow_header_size
+#define slice_cow_refs(data,header) ((slice_atomic(size_t)*)((char*)(data) - (header)))
+
+//allocates a cow buffer with a header of header bytes for cap elements of elem_size bytes with a reference count of 1,
+//returns a pointer to its first element or NULL on error.
+static inline void* slice_cow_alloc(size_t cap,size_t elem_size,size_t header){
+    char* block;
+    if(cap > (((size_t)-1) - header)/elem_size){return NULL;}
+    block = slice_calloc(char,header + cap*elem_size);
+    if(slice_alloc_failed(block)){return NULL;}
+    slice_atomic_init((slice_atomic(size_t)*)block,1);
+    return block + header;
+}
+
+//reallocates a cow buffer that only one handle refers to, returns a pointer to its first element or NULL on error (data stays valid).
+static inline void* slice_cow_realloc(void* data,size_t cap,size_t elem_size,size_t header){
+    char* block;
+    if(cap > (((size_t)-1) - header)/elem_size){return NULL;}
+    block = slice_realloc(char,(char*)data - header,header + cap*elem_size);
+    if(slice_alloc_failed(block)){return NULL;}
+    return block + header;
+}
+
+//drops one reference to a cow buffer and frees it if it was the last one.
+static inline void slice_cow_release(void* data,size_t header){
+    if(slice_atomic_fetch_sub(slice_cow_refs(data,header),1,acq_rel) == 1){slice_free((char*)data - header);}
+}
+
+/*
+$name $name_make (size_t cap) creates a cow slice with the given capacity, when done with it you MUST call
+$name_destroy on it (and on every clone of it) to prevent memory leaks.
+*/
+#define define_slice_cow_make(name,type) SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t cap){\
+    name output = {NULL,0,cap};\
+    if(slice_unsafe_value_cap(output) == 0){slice_unsafe_value_cap(output) = 10;}\
+    slice_unsafe_value_storage_ptr(output) = (type*)slice_cow_alloc(slice_unsafe_value_cap(output),sizeof(type),slice_cow_header_size(name,type));\
+    if(slice_unsafe_value_storage_ptr(output) == NULL){slice_unsafe_value_cap(output) = 0;}\
+    return output;\
+} SLICE_C_END
+
+/*
+$name $name_clone($name* the_thing) makes another handle to the buffer of a cow slice without copying the elements,
+the clone MUST be destroyed with $name_destroy like any other slice.
+*/
+#define define_slice_cow_clone(name,type) SLICE_C_BEGIN name ___slice_function_name___(clone,name)(name* the_thing){\
+    name output = *the_thing;\
+    if(slice_unsafe_value_storage_ptr(output) != NULL){slice_atomic_fetch_add(slice_cow_refs(slice_unsafe_value_storage_ptr(output),slice_cow_header_size(name,type)),1,relaxed);}\
+    return output;\
+} SLICE_C_END
+
+/*
+void $name_destroy(name* the_thing) destroys a handle of a cow slice, the buffer is freed with the last handle to it,
+the handle MUST NOT be used after this function is called;
+*/
+#define define_slice_cow_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_cow_release(slice_unsafe_raw_storage_ptr(the_thing),slice_cow_header_size(name,type));}\
+    slice_unsafe_raw_storage_ptr(the_thing) = NULL;\
+    slice_unsafe_raw_cap(the_thing) = 0;slice_unsafe_raw_len(the_thing) = 0;\
+} SLICE_C_END
+
+/*
+int $name_is_shared($name* the_thing) returns 1 if other handles refer to the buffer of a cow slice, 0 otherwise.
+*/
+#define define_slice_cow_is_shared(name,type) SLICE_C_BEGIN int ___slice_function_name___(is_shared,name)(name* the_thing){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    return slice_atomic_load(slice_cow_refs(slice_unsafe_raw_storage_ptr(the_thing),slice_cow_header_size(name,type)),acquire) > 1;\
+} SLICE_C_END
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure a cow slice owns its buffer and that its capacity is at least new_cap,
+a shared buffer is copied (and the copy is new_cap elements if that is larger), returns 0 on failure and 1 on success,
+the slice is left untouched on failure.
+*/
+#define define_slice_cow_reserve(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    type* grown;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(new_cap < slice_unsafe_raw_cap(the_thing)){new_cap = slice_unsafe_raw_cap(the_thing);}\
+    if(slice_atomic_load(slice_cow_refs(slice_unsafe_raw_storage_ptr(the_thing),slice_cow_header_size(name,type)),acquire) == 1){\
+        if(new_cap == slice_unsafe_raw_cap(the_thing)){return 1;}\
+        grown = (type*)slice_cow_realloc(slice_unsafe_raw_storage_ptr(the_thing),new_cap,sizeof(type),slice_cow_header_size(name,type));\
+        if(grown == NULL){return 0;}\
+    }else{\
+        grown = (type*)slice_cow_alloc(new_cap,sizeof(type),slice_cow_header_size(name,type));\
+        if(grown == NULL){return 0;}\
+        slice_memcpy(type,grown,slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+        slice_cow_release(slice_unsafe_raw_storage_ptr(the_thing),slice_cow_header_size(name,type));\
+    }\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_detach($name* the_thing) makes sure a cow slice owns its buffer, copying it if it is shared,
+returns 0 on failure and 1 on success.
+*/
+#define define_slice_cow_detach(name,type) SLICE_C_BEGIN int ___slice_function_name___(detach,name)(name* the_thing){\
+    return ___slice_function_name___(reserve,name)(the_thing,0);\
+} SLICE_C_END
+
+/*
+int $name_grow ($name* the_thing,size_t needed) makes sure a cow slice owns its buffer and that its capacity is at least needed,
+the new capacity is chosen by SLICE_GROWTH_POLICY, returns 0 on failure and 1 on success.
+*/
+#define define_slice_cow_grow(name,type) SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed){\
+    size_t new_cap;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(needed <= slice_unsafe_raw_cap(the_thing)){return ___slice_function_name___(reserve,name)(the_thing,0);}\
+    new_cap = SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),needed,sizeof(type));\
+    if(new_cap < needed){new_cap = needed;}\
+    return ___slice_function_name___(reserve,name)(the_thing,new_cap);\
+} SLICE_C_END
+
+/*
+int $name_append ($name* the_thing,type arg) appends an item to a cow slice, returns 0 on failure and 1 on success.
+*/
+#define define_slice_cow_append(name,type) SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,type arg){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing)+1))){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing)[slice_unsafe_raw_len(the_thing)] = arg;\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_append_n ($name* the_thing,const type* src,size_t n) appends n items from src to a cow slice, returns 0 on failure and 1 on success,
+src must not point into the buffer of the_thing.
+*/
+#define define_slice_cow_append_n(name,type) SLICE_C_BEGIN int ___slice_function_name___(append_n,name)(name* the_thing,const type* src,size_t n){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||(src == NULL && n != 0)){return 0;}\
+    if(n == 0){return 1;}\
+    if(n > slice_max_cap(type) - slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_grow_failed(___slice_function_name___(grow,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing) + slice_unsafe_raw_len(the_thing),src,n);\
+    slice_unsafe_raw_len(the_thing) += n;\
+    return 1;\
+} SLICE_C_END
+
+/*
+void $name_set(name* the_thing,size_t index,$type result) sets the value at an index (index < the slice length) of a cow slice,
+nothing is written if copying a shared buffer fails, use $name_bounded_set to find out.
+*/
+#define define_slice_cow_set(name,type) SLICE_C_BEGIN void ___slice_function_name___(set,name)(name* the_thing,size_t index,type result){\
+    if(slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,0))){return;}\
+    slice_unsafe_raw_storage_ptr(the_thing)[index] = result;\
+} SLICE_C_END
+
+/*
+int $name_bounded_set ($name* the_thing,size_t index,type result) sets the value of a cow slice at index 'index',
+returns 1 on success and 0 on error.
+*/
+#define define_slice_cow_bounded_set(name,type) SLICE_C_BEGIN int ___slice_function_name___(bounded_set,name)(name* the_thing,size_t index,type result){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||index >= slice_unsafe_raw_len(the_thing)){return 0;}\
+    if(slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,0))){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing)[index] = result;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_resize($name* slice,size_t new_len) sets the length (and maybe capacity) of a cow slice,
+returns 1 on success and 0 on error.
+*/
+#define define_slice_cow_resize(name,type) SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(slice_grow_failed(___slice_function_name___(grow,name)(the_thing,new_size))){return 0;}\
+    slice_unsafe_raw_len(the_thing) = new_size;\
+    return 1;\
+} SLICE_C_END
+
+/*
+define_slice_cow_all_funct_decl(name,type) creates the declarations of every function of a cow slice.
+*/
+#define define_slice_cow_all_funct_decl(name,type) \
+define_slice_make_decl(name,type);\
+SLICE_C_BEGIN name ___slice_function_name___(clone,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(is_shared,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(detach,name)(name* the_thing); SLICE_C_END;\
+define_slice_destroy_decl(name,type);\
+define_slice_append_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+define_slice_at_decl(name,type);\
+define_slice_set_decl(name,type);\
+define_slice_bounded_at_decl(name,type);\
+define_slice_bounded_set_decl(name,type);\
+define_slice_pop_decl(name,type);\
+define_slice_ok_decl(name,type);\
+define_slice_length_decl(name);\
+define_slice_cap_decl(name);\
+define_slice_resize_decl(name,type);\
+define_slice_reserve_decl(name,type);\
+define_slice_grow_decl(name,type)
+
+/*
+define_slice_cow_declarations(name,type) creates a cow slice named $name for $type and the declarations of its functions.
+*/
+#define define_slice_cow_declarations(name,type) define_slice_struct(name,type);\
+SLICE_C_BEGIN typedef struct ___slice_function_name___(cow_align,name){char c;type t;} ___slice_function_name___(cow_align,name); SLICE_C_END;\
+define_slice_cow_all_funct_decl(name,type);define_slice_view_decl(name,type)
+
+/*
+define_slice_cow_definitions(name,type) creates all the function definitions to use a cow slice.
+define_slice_cow_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_struct).
+*/
+#define define_slice_cow_definitions(name,type) define_slice_cow_make(name,type);\
+define_slice_cow_clone(name,type);\
+define_slice_cow_destroy(name,type);\
+define_slice_cow_is_shared(name,type);\
+define_slice_cow_reserve(name,type);\
+define_slice_cow_detach(name,type);\
+define_slice_cow_grow(name,type);\
+define_slice_cow_append(name,type);\
+define_slice_cow_append_n(name,type);\
+define_slice_at(name,type);\
+define_slice_cow_set(name,type);\
+define_slice_bounded_at(name,type);\
+define_slice_cow_bounded_set(name,type);\
+define_slice_pop(name,type);\
+define_slice_ok(name,type);\
+define_slice_length(name);\
+define_slice_cap(name);\
+define_slice_cow_resize(name,type);\
+define_slice_view_definitions(name,type)
+
+/*
+define_slice_cow(name,type) creates a copy on write slice named $name to act as a dynamic array container for $type
+whose buffer is shared between handles until one of them writes to it, as described above.
+If you wish to seperate the functions from the declearations you may use
+define_slice_cow_declarations(name,type) and define_slice_cow_definitions(name,type).
+It has the functions of a regular slice listed in define_slice_cow_all_funct_decl plus:
+
+//$name $name_clone($name* the_thing) makes another handle to the same buffer in O(1), destroy it like any slice.
+$name $name_clone($name* the_thing);
+
+//int $name_is_shared($name* the_thing) returns 1 if other handles refer to the buffer.
+int $name_is_shared($name* the_thing);
+
+//int $name_detach($name* the_thing) copies the buffer if it is shared, returns 0 on failure and 1 on success.
+int $name_detach($name* the_thing);
+
+Views ($name_as_view,$name_subslice,...) read the buffer without copying it, they are invalidated by any write through the handle they were made from.
+*/
+#define define_slice_cow(name,type) define_slice_cow_declarations(name,type);define_slice_cow_definitions(name,type)
+
+
+
+
+#endif
@@ -0,0 +1,541 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_HASH
+
+
+#define CUSTOM_SLICES_HASH 1
+#include "slice.h"
+
+/*
+This file adds hash maps and hash sets stored in slice allocated arrays.
+
+The tables use open addressing with a byte of metadata (control byte) per slot, like swiss tables:
+a control byte is either empty, deleted, or 7 bits of the hash of the key in the slot.
+A lookup loads the control bytes of 16 slots at once and compares all of them with the 7 bits of the hash
+of the key (one SSE2 compare on x86, a loop elsewhere), so only slots whose 7 bits match are compared with EQ,
+and it stops at the first group of 16 that has an empty slot.
+The capacity is a power of 2 (at least 16) and the tables grow when 7/8 of the slots are used.
+
+For the remainder of this section, $name is the name of the custom type you definied.
+HASH is a function-like macro or an inline function taking a key and returning an integer (size_t),
+EQ is a function-like macro or an inline function taking two keys that is nonzero if they are equal.
+The hash is mixed again before it is used, so a cheap HASH (like the integer itself) is fine.
+For example:
+#define int_hash(x) ((size_t)(x))
+#define int_eq(a,b) ((a) == (b))
+#define str_hash(s) slice_hash_str(s)
+#define str_eq(a,b) (strcmp(a,b) == 0)
+
+define_slice_hashmap(name,key_type,value_type,HASH,EQ) creates the struct $name, the struct $name_entry {key_type key;value_type value;}
+and the following functions:
+
+//$name $name_make(size_t n) creates a map that holds n entries without growing, when done with the map you MUST call
+//$name_destroy on it to prevent memory leaks, $name_ok returns 0 if the allocation failed.
+$name $name_make(size_t n);
+void $name_destroy($name* the_thing);
+int $name_ok($name the_thing);
+
+//size_t $name_length($name the_thing) returns the number of entries, size_t $name_cap($name the_thing) the number of slots.
+size_t $name_length($name the_thing);
+size_t $name_cap($name the_thing);
+
+//int $name_reserve($name* the_thing,size_t n) makes sure the map holds n entries without growing, returns 0 on failure and 1 on success.
+int $name_reserve($name* the_thing,size_t n);
+
+//int $name_insert($name* the_thing,key_type key,value_type value) inserts an entry or replaces the value of key,
+//returns 0 on failure (the map is left unchanged) and 1 on success.
+int $name_insert($name* the_thing,key_type key,value_type value);
+
+//value_type* $name_find($name* the_thing,key_type key) returns a pointer to the value of key or NULL,
+//the pointer is invalidated by the next insert.
+value_type* $name_find($name* the_thing,key_type key);
+
+//int $name_get($name* the_thing,key_type key,value_type* result) copies the value of key into result, returns 0 if key is not in the map.
+int $name_get($name* the_thing,key_type key,value_type* result);
+
+//int $name_contains($name* the_thing,key_type key) returns 1 if key is in the map, 0 otherwise.
+int $name_contains($name* the_thing,key_type key);
+
+//int $name_remove($name* the_thing,key_type key) removes key, returns 1 if it was in the map, 0 otherwise.
+int $name_remove($name* the_thing,key_type key);
+
+//void $name_clear($name* the_thing) removes every entry and keeps the capacity.
+void $name_clear($name* the_thing);
+
+//$name_entry* $name_next($name* the_thing,size_t* cursor) iterates over the entries in no particular order,
+//start with *cursor = 0, returns NULL after the last entry. The map must not be changed while iterating
+//(except through the returned entry's value).
+$name_entry* $name_next($name* the_thing,size_t* cursor);
+
+//int $name_insert_n($name* the_thing,const key_type* keys,const value_type* values,size_t n) inserts n entries,
+//the table grows at most once and the hashes of a batch of keys are computed and their control bytes prefetched
+//before any of them is probed, so the cache misses of the batch overlap. Returns 0 on failure and 1 on success.
+int $name_insert_n($name* the_thing,const key_type* keys,const value_type* values,size_t n);
+
+//size_t $name_find_n($name* the_thing,const key_type* keys,size_t n,value_type** results) looks up n keys in batches like
+//$name_insert_n, results[i] is a pointer to the value of keys[i] or NULL, returns the number of keys that were found.
+size_t $name_find_n($name* the_thing,const key_type* keys,size_t n,value_type** results);
+
+define_slice_hashset(name,key_type,HASH,EQ) creates the struct $name and the same functions for a set of keys,
+except that:
+int $name_insert($name* the_thing,key_type key);
+key_type* $name_next($name* the_thing,size_t* cursor);
+int $name_insert_n($name* the_thing,const key_type* keys,size_t n);
+size_t $name_find_n($name* the_thing,const key_type* keys,size_t n,key_type** results);     results[i] points to the stored key or is NULL
+and there is no $name_find or $name_get.
+
+Use define_slice_hashmap_decl/define_slice_hashmap_definitions (define_slice_hashset_decl/define_slice_hashset_definitions)
+to seperate the declarations from the definitions.
+*/
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define SLICE_HASH_SSE2 1
+#endif
+
+//the number of control bytes probed at once
+#define SLICE_HASH_GROUP 16
+//the control byte of a slot that was never used
+#define SLICE_HASH_EMPTY ((unsigned char)0x80)
+//the control byte of a slot whose entry was removed
+#define SLICE_HASH_DELETED ((unsigned char)0xFE)
+
+#ifndef SLICE_HASH_BATCH
+//$name_insert_n and $name_find_n hash and prefetch this many keys before probing them
+#define SLICE_HASH_BATCH 16
+#endif
+
+//mixes the bits of a hash so every bit of h affects the slot and the 7 bits stored in the control byte
+static inline size_t slice_hash_mix(size_t h){
+    unsigned long long x = (unsigned long long)h;
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93ull;
+    x ^= x >> 32;
+    x *= 0xd6e8feb86659fd93ull;
+    x ^= x >> 32;
+    return (size_t)x;
+}
+
+//size_t slice_hash_bytes(const void* data,size_t len) hashes len bytes (FNV-1a), to use in HASH.
+static inline size_t slice_hash_bytes(const void* data,size_t len){
+    const unsigned char* bytes = (const unsigned char*)data;
+    unsigned long long h = 0xcbf29ce484222325ull;
+    size_t i;
+    for(i = 0;i < len;i++){h = (h ^ bytes[i])*0x100000001b3ull;}
+    return (size_t)h;
+}
+
+//size_t slice_hash_str(const char* str) hashes a NUL terminated string (FNV-1a), to use in HASH.
+static inline size_t slice_hash_str(const char* str){
+    unsigned long long h = 0xcbf29ce484222325ull;
+    for(;*str;str++){h = (h ^ (unsigned char)*str)*0x100000001b3ull;}
+    return (size_t)h;
+}
+
+//bit i is set if control byte i of the group at ctrl is h2
+static inline unsigned slice_hash_match(const unsigned char* ctrl,unsigned char h2){
+#ifdef SLICE_HASH_SSE2
+    __m128i group = _mm_loadu_si128((const __m128i*)ctrl);
+    return (unsigned)_mm_movemask_epi8(_mm_cmpeq_epi8(group,_mm_set1_epi8((char)h2)));
+#else
+    unsigned out = 0;
+    int i;
+    for(i = 0;i < SLICE_HASH_GROUP;i++){out |= (unsigned)(ctrl[i] == h2) << i;}
+    return out;
+#endif
+}
+
+//bit i is set if slot i of the group at ctrl is empty or deleted (the high bit of its control byte is set)
+static inline unsigned slice_hash_match_free(const unsigned char* ctrl){
+#ifdef SLICE_HASH_SSE2
+    return (unsigned)_mm_movemask_epi8(_mm_loadu_si128((const __m128i*)ctrl));
+#else
+    unsigned out = 0;
+    int i;
+    for(i = 0;i < SLICE_HASH_GROUP;i++){out |= (unsigned)(ctrl[i] >> 7) << i;}
+    return out;
+#endif
+}
+
+//the index of the lowest set bit of mask (mask != 0)
+static inline unsigned slice_hash_first(unsigned mask){
+#if defined(__GNUC__) || defined(__clang__)
+    return (unsigned)__builtin_ctz(mask);
+#else
+    unsigned i = 0;
+    while(!(mask & 1u)){mask >>= 1;i++;}
+    return i;
+#endif
+}
+
+//the number of slots of a table that holds n entries without growing, 0 if it is too large
+static inline size_t slice_hash_capacity(size_t n){
+    size_t cap = SLICE_HASH_GROUP;
+    while(cap - cap/8 < n){
+        if(cap > ((size_t)-1)/4){return 0;}
+        cap <<= 1;
+    }
+    return cap;
+}
+
+//sets the control byte of slot i, the first SLICE_HASH_GROUP control bytes are mirrored after the last slot
+//so a group can be loaded at any slot without wrapping around
+static inline void slice_hash_set_ctrl(unsigned char* ctrl,size_t cap,size_t i,unsigned char value){
+    ctrl[i] = value;
+    ctrl[((i - SLICE_HASH_GROUP) & (cap - 1)) + SLICE_HASH_GROUP] = value;
+}
+
+//returns the first empty or deleted slot on the probe sequence of hash (the table is never full)
+static inline size_t slice_hash_free_slot(const unsigned char* ctrl,size_t cap,size_t hash){
+    size_t mask = cap - 1;
+    size_t pos = (hash >> 7) & mask,step = 0;
+    unsigned match;
+    while(!(match = slice_hash_match_free(ctrl + pos))){
+        step += SLICE_HASH_GROUP;
+        pos = (pos + step) & mask;
+    }
+    return (pos + slice_hash_first(match)) & mask;
+}
+
+//the number of entries a table of cap slots holds before it grows
+#define slice_hash_max_load(cap) ((cap) - (cap)/8)
+
+//the key of an entry of a hash map
+#define ___slice_hash_map_key___(entry) ((entry).key)
+//the key of an entry of a hash set
+#define ___slice_hash_set_key___(entry) (entry)
+
+/*
+define_slice_hashmap_struct(name,key_type,value_type) creates the entry struct and the table struct of a hash map,
+the attributes should not be accessed directly unless you know what your doing.
+*/
+#define define_slice_hashmap_struct(name,key_type,value_type) SLICE_C_BEGIN typedef struct ___slice_function_name___(entry,name) {key_type key;value_type value;} ___slice_function_name___(entry,name);\
+typedef struct name { ___slice_function_name___(entry,name)* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;unsigned char* ctrl;size_t growth_left;} name; SLICE_C_END
+
+/*
+define_slice_hashset_struct(name,key_type) creates the table struct of a hash set,
+the attributes should not be accessed directly unless you know what your doing.
+*/
+#define define_slice_hashset_struct(name,key_type) SLICE_C_BEGIN typedef struct name { key_type* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;unsigned char* ctrl;size_t growth_left;} name; SLICE_C_END
+
+/*
+___slice_hash_common_decl___(name,entry,key_type) declares the functions shared by hash maps and hash sets.
+*/
+#define ___slice_hash_common_decl___(name,entry,key_type) \
+SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t n); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name the_thing); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(cap,name)(name the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t n); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(contains,name)(name* the_thing,key_type key); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(remove,name)(name* the_thing,key_type key); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(clear,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN entry* ___slice_function_name___(next,name)(name* the_thing,size_t* cursor); SLICE_C_END
+
+/*
+___slice_hash_common___(name,entry,key_type,KEY_OF,HASH,EQ) defines the table functions shared by hash maps and hash sets,
+KEY_OF(entry) is the key of an entry.
+*/
+#define ___slice_hash_common___(name,entry,key_type,KEY_OF,HASH,EQ) \
+static inline size_t ___slice_function_name___(hash_of,name)(key_type key){\
+    return slice_hash_mix((size_t)(HASH(key)));\
+}\
+static size_t ___slice_function_name___(hash_find,name)(name* the_thing,key_type key,size_t hash){\
+    size_t mask = slice_unsafe_raw_cap(the_thing) - 1;\
+    size_t pos = (hash >> 7) & mask,step = 0;\
+    unsigned char h2 = (unsigned char)(hash & 0x7f);\
+    unsigned match;\
+    for(;;){\
+        match = slice_hash_match(the_thing->ctrl + pos,h2);\
+        while(match){\
+            size_t i = (pos + slice_hash_first(match)) & mask;\
+            if(EQ(KEY_OF(slice_unsafe_raw_storage_ptr(the_thing)[i]),key)){return i;}\
+            match &= match - 1;\
+        }\
+        if(slice_hash_match(the_thing->ctrl + pos,SLICE_HASH_EMPTY)){return slice_unsafe_raw_cap(the_thing);}\
+        step += SLICE_HASH_GROUP;\
+        pos = (pos + step) & mask;\
+    }\
+}\
+static void ___slice_function_name___(hash_find_batch,name)(name* the_thing,const key_type* keys,size_t count,size_t* slots){\
+    size_t hashes[SLICE_HASH_BATCH];\
+    size_t mask = slice_unsafe_raw_cap(the_thing) - 1;\
+    size_t j;\
+    for(j = 0;j < count;j++){\
+        hashes[j] = ___slice_function_name___(hash_of,name)(keys[j]);\
+        slice_prefetch(the_thing->ctrl + ((hashes[j] >> 7) & mask));\
+    }\
+    for(j = 0;j < count;j++){slots[j] = ___slice_function_name___(hash_find,name)(the_thing,keys[j],hashes[j]);}\
+}\
+static int ___slice_function_name___(hash_resize,name)(name* the_thing,size_t new_cap){\
+    unsigned char* ctrl;\
+    entry* data;\
+    size_t i,slot,hash;\
+    if(new_cap == 0||new_cap > slice_max_cap(entry)){return 0;}\
+    ctrl = slice_calloc(unsigned char,new_cap + SLICE_HASH_GROUP);\
+    data = slice_calloc(entry,new_cap);\
+    if(slice_alloc_failed(ctrl)||slice_alloc_failed(data)){\
+        if(ctrl != NULL){slice_free(ctrl);}\
+        if(data != NULL){slice_free(data);}\
+        return 0;\
+    }\
+    SLICE_UNSAFE_MEMSET(ctrl,SLICE_HASH_EMPTY,new_cap + SLICE_HASH_GROUP);\
+    for(i = 0;i < slice_unsafe_raw_cap(the_thing);i++){\
+        if(the_thing->ctrl[i] & 0x80){continue;}\
+        hash = ___slice_function_name___(hash_of,name)(KEY_OF(slice_unsafe_raw_storage_ptr(the_thing)[i]));\
+        slot = slice_hash_free_slot(ctrl,new_cap,hash);\
+        slice_hash_set_ctrl(ctrl,new_cap,slot,(unsigned char)(hash & 0x7f));\
+        data[slot] = slice_unsafe_raw_storage_ptr(the_thing)[i];\
+    }\
+    if(the_thing->ctrl != NULL){slice_free(the_thing->ctrl);}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_free(slice_unsafe_raw_storage_ptr(the_thing));}\
+    the_thing->ctrl = ctrl;\
+    slice_unsafe_raw_storage_ptr(the_thing) = data;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    the_thing->growth_left = slice_hash_max_load(new_cap) - slice_unsafe_raw_len(the_thing);\
+    return 1;\
+}\
+static size_t ___slice_function_name___(hash_prepare,name)(name* the_thing,key_type key,size_t hash,int* found){\
+    size_t cap = slice_unsafe_raw_cap(the_thing);\
+    size_t i = ___slice_function_name___(hash_find,name)(the_thing,key,hash);\
+    if(i != cap){*found = 1;return i;}\
+    *found = 0;\
+    if(the_thing->growth_left == 0){\
+        if(cap > ((size_t)-1)/2||slice_grow_failed(___slice_function_name___(hash_resize,name)(the_thing,\
+            slice_unsafe_raw_len(the_thing) < slice_hash_max_load(cap)/2 ? cap : cap*2))){return (size_t)-1;}\
+        cap = slice_unsafe_raw_cap(the_thing);\
+    }\
+    i = slice_hash_free_slot(the_thing->ctrl,cap,hash);\
+    if(the_thing->ctrl[i] == SLICE_HASH_EMPTY){the_thing->growth_left--;}\
+    slice_hash_set_ctrl(the_thing->ctrl,cap,i,(unsigned char)(hash & 0x7f));\
+    slice_unsafe_raw_len(the_thing)++;\
+    return i;\
+}\
+SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t n){\
+    name output = {NULL,0,0,NULL,0};\
+    size_t cap = slice_hash_capacity(n);\
+    if(cap == 0||cap > slice_max_cap(entry)){return output;}\
+    output.ctrl = slice_calloc(unsigned char,cap + SLICE_HASH_GROUP);\
+    slice_unsafe_value_storage_ptr(output) = slice_calloc(entry,cap);\
+    if(slice_alloc_failed(output.ctrl)||slice_alloc_failed(slice_unsafe_value_storage_ptr(output))){\
+        if(output.ctrl != NULL){slice_free(output.ctrl);}\
+        if(slice_unsafe_value_storage_ptr(output) != NULL){slice_free(slice_unsafe_value_storage_ptr(output));}\
+        output.ctrl = NULL;\
+        slice_unsafe_value_storage_ptr(output) = NULL;\
+        return output;\
+    }\
+    SLICE_UNSAFE_MEMSET(output.ctrl,SLICE_HASH_EMPTY,cap + SLICE_HASH_GROUP);\
+    slice_unsafe_value_cap(output) = cap;\
+    output.growth_left = slice_hash_max_load(cap);\
+    return output;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    if(the_thing == NULL){return;}\
+    if(the_thing->ctrl != NULL){slice_free(the_thing->ctrl);}\
+    if(slice_unsafe_raw_storage_ptr(the_thing) != NULL){slice_free(slice_unsafe_raw_storage_ptr(the_thing));}\
+    the_thing->ctrl = NULL;\
+    slice_unsafe_raw_storage_ptr(the_thing) = NULL;\
+    slice_unsafe_raw_len(the_thing) = 0;slice_unsafe_raw_cap(the_thing) = 0;the_thing->growth_left = 0;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing){\
+    return slice_unsafe_value_storage_ptr(the_thing) != NULL && the_thing.ctrl != NULL;\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(length,name)(name the_thing){\
+    return slice_unsafe_value_len(the_thing);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(cap,name)(name the_thing){\
+    return slice_unsafe_value_cap(the_thing);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t n){\
+    size_t cap;\
+    if(the_thing == NULL||the_thing->ctrl == NULL){return 0;}\
+    if(n <= slice_unsafe_raw_len(the_thing) + the_thing->growth_left){return 1;}\
+    cap = slice_hash_capacity(n);\
+    if(cap < slice_unsafe_raw_cap(the_thing)){cap = slice_unsafe_raw_cap(the_thing);}\
+    return ___slice_function_name___(hash_resize,name)(the_thing,cap);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(contains,name)(name* the_thing,key_type key){\
+    if(the_thing == NULL||the_thing->ctrl == NULL||slice_unsafe_raw_len(the_thing) == 0){return 0;}\
+    return ___slice_function_name___(hash_find,name)(the_thing,key,___slice_function_name___(hash_of,name)(key)) != slice_unsafe_raw_cap(the_thing);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(remove,name)(name* the_thing,key_type key){\
+    size_t i;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||slice_unsafe_raw_len(the_thing) == 0){return 0;}\
+    i = ___slice_function_name___(hash_find,name)(the_thing,key,___slice_function_name___(hash_of,name)(key));\
+    if(i == slice_unsafe_raw_cap(the_thing)){return 0;}\
+    slice_hash_set_ctrl(the_thing->ctrl,slice_unsafe_raw_cap(the_thing),i,SLICE_HASH_DELETED);\
+    slice_unsafe_raw_len(the_thing)--;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(clear,name)(name* the_thing){\
+    if(the_thing == NULL||the_thing->ctrl == NULL){return;}\
+    SLICE_UNSAFE_MEMSET(the_thing->ctrl,SLICE_HASH_EMPTY,slice_unsafe_raw_cap(the_thing) + SLICE_HASH_GROUP);\
+    slice_unsafe_raw_len(the_thing) = 0;\
+    the_thing->growth_left = slice_hash_max_load(slice_unsafe_raw_cap(the_thing));\
+} SLICE_C_END;\
+SLICE_C_BEGIN entry* ___slice_function_name___(next,name)(name* the_thing,size_t* cursor){\
+    size_t i;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||cursor == NULL){return NULL;}\
+    for(i = *cursor;i < slice_unsafe_raw_cap(the_thing);i++){\
+        if(!(the_thing->ctrl[i] & 0x80)){*cursor = i + 1;return slice_unsafe_raw_storage_ptr(the_thing) + i;}\
+    }\
+    *cursor = slice_unsafe_raw_cap(the_thing);\
+    return NULL;\
+} SLICE_C_END
+
+/*
+define_slice_hashmap_decl(name,key_type,value_type) creates the structs of a hash map and the declarations of its functions.
+*/
+#define define_slice_hashmap_decl(name,key_type,value_type) define_slice_hashmap_struct(name,key_type,value_type);\
+___slice_hash_common_decl___(name,___slice_function_name___(entry,name),key_type);\
+SLICE_C_BEGIN int ___slice_function_name___(insert,name)(name* the_thing,key_type key,value_type value); SLICE_C_END;\
+SLICE_C_BEGIN value_type* ___slice_function_name___(find,name)(name* the_thing,key_type key); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(get,name)(name* the_thing,key_type key,value_type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,const key_type* keys,const value_type* values,size_t n); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(find_n,name)(name* the_thing,const key_type* keys,size_t n,value_type** results); SLICE_C_END
+
+/*
+define_slice_hashmap_definitions(name,key_type,value_type,HASH,EQ) creates the function definitions of a hash map.
+define_slice_hashmap_decl MUST be used prior to this with the same name and types.
+*/
+#define define_slice_hashmap_definitions(name,key_type,value_type,HASH,EQ) \
+___slice_hash_common___(name,___slice_function_name___(entry,name),key_type,___slice_hash_map_key___,HASH,EQ);\
+SLICE_C_BEGIN int ___slice_function_name___(insert,name)(name* the_thing,key_type key,value_type value){\
+    size_t i;\
+    int found;\
+    if(the_thing == NULL||the_thing->ctrl == NULL){return 0;}\
+    i = ___slice_function_name___(hash_prepare,name)(the_thing,key,___slice_function_name___(hash_of,name)(key),&found);\
+    if(i == (size_t)-1){return 0;}\
+    if(!found){slice_unsafe_raw_storage_ptr(the_thing)[i].key = key;}\
+    slice_unsafe_raw_storage_ptr(the_thing)[i].value = value;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN value_type* ___slice_function_name___(find,name)(name* the_thing,key_type key){\
+    size_t i;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||slice_unsafe_raw_len(the_thing) == 0){return NULL;}\
+    i = ___slice_function_name___(hash_find,name)(the_thing,key,___slice_function_name___(hash_of,name)(key));\
+    return i == slice_unsafe_raw_cap(the_thing) ? NULL : &slice_unsafe_raw_storage_ptr(the_thing)[i].value;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(get,name)(name* the_thing,key_type key,value_type* result){\
+    value_type* value = ___slice_function_name___(find,name)(the_thing,key);\
+    if(value == NULL||result == NULL){return 0;}\
+    *result = *value;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,const key_type* keys,const value_type* values,size_t n){\
+    size_t hashes[SLICE_HASH_BATCH];\
+    size_t i,j,count,slot,mask;\
+    int found;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||((keys == NULL||values == NULL) && n != 0)){return 0;}\
+    if(n > ((size_t)-1) - slice_unsafe_raw_len(the_thing)||\
+        slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    mask = slice_unsafe_raw_cap(the_thing) - 1;\
+    for(i = 0;i < n;i += count){\
+        count = n - i < SLICE_HASH_BATCH ? n - i : SLICE_HASH_BATCH;\
+        for(j = 0;j < count;j++){\
+            hashes[j] = ___slice_function_name___(hash_of,name)(keys[i + j]);\
+            slice_prefetch(the_thing->ctrl + ((hashes[j] >> 7) & mask));\
+        }\
+        for(j = 0;j < count;j++){\
+            slot = ___slice_function_name___(hash_prepare,name)(the_thing,keys[i + j],hashes[j],&found);\
+            if(slot == (size_t)-1){return 0;}\
+            if(!found){slice_unsafe_raw_storage_ptr(the_thing)[slot].key = keys[i + j];}\
+            slice_unsafe_raw_storage_ptr(the_thing)[slot].value = values[i + j];\
+        }\
+    }\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(find_n,name)(name* the_thing,const key_type* keys,size_t n,value_type** results){\
+    size_t slots[SLICE_HASH_BATCH];\
+    size_t i,j,count,found = 0;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||keys == NULL||results == NULL){return 0;}\
+    for(i = 0;i < n;i += count){\
+        count = n - i < SLICE_HASH_BATCH ? n - i : SLICE_HASH_BATCH;\
+        ___slice_function_name___(hash_find_batch,name)(the_thing,keys + i,count,slots);\
+        for(j = 0;j < count;j++){\
+            if(slots[j] == slice_unsafe_raw_cap(the_thing)){results[i + j] = NULL;continue;}\
+            results[i + j] = &slice_unsafe_raw_storage_ptr(the_thing)[slots[j]].value;\
+            found++;\
+        }\
+    }\
+    return found;\
+} SLICE_C_END
+
+/*
+define_slice_hashmap(name,key_type,value_type,HASH,EQ) creates a hash map named $name from key_type to value_type
+as described at the top of this file.
+*/
+#define define_slice_hashmap(name,key_type,value_type,HASH,EQ) define_slice_hashmap_decl(name,key_type,value_type);define_slice_hashmap_definitions(name,key_type,value_type,HASH,EQ)
+
+/*
+define_slice_hashset_decl(name,key_type) creates the struct of a hash set and the declarations of its functions.
+*/
+#define define_slice_hashset_decl(name,key_type) define_slice_hashset_struct(name,key_type);\
+___slice_hash_common_decl___(name,key_type,key_type);\
+SLICE_C_BEGIN int ___slice_function_name___(insert,name)(name* the_thing,key_type key); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,const key_type* keys,size_t n); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(find_n,name)(name* the_thing,const key_type* keys,size_t n,key_type** results); SLICE_C_END
+
+/*
+define_slice_hashset_definitions(name,key_type,HASH,EQ) creates the function definitions of a hash set.
+define_slice_hashset_decl MUST be used prior to this with the same name and type.
+*/
+#define define_slice_hashset_definitions(name,key_type,HASH,EQ) \
+___slice_hash_common___(name,key_type,key_type,___slice_hash_set_key___,HASH,EQ);\
+SLICE_C_BEGIN int ___slice_function_name___(insert,name)(name* the_thing,key_type key){\
+    size_t i;\
+    int found;\
+    if(the_thing == NULL||the_thing->ctrl == NULL){return 0;}\
+    i = ___slice_function_name___(hash_prepare,name)(the_thing,key,___slice_function_name___(hash_of,name)(key),&found);\
+    if(i == (size_t)-1){return 0;}\
+    if(!found){slice_unsafe_raw_storage_ptr(the_thing)[i] = key;}\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(insert_n,name)(name* the_thing,const key_type* keys,size_t n){\
+    size_t hashes[SLICE_HASH_BATCH];\
+    size_t i,j,count,slot,mask;\
+    int found;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||(keys == NULL && n != 0)){return 0;}\
+    if(n > ((size_t)-1) - slice_unsafe_raw_len(the_thing)||\
+        slice_grow_failed(___slice_function_name___(reserve,name)(the_thing,slice_unsafe_raw_len(the_thing) + n))){return 0;}\
+    mask = slice_unsafe_raw_cap(the_thing) - 1;\
+    for(i = 0;i < n;i += count){\
+        count = n - i < SLICE_HASH_BATCH ? n - i : SLICE_HASH_BATCH;\
+        for(j = 0;j < count;j++){\
+            hashes[j] = ___slice_function_name___(hash_of,name)(keys[i + j]);\
+            slice_prefetch(the_thing->ctrl + ((hashes[j] >> 7) & mask));\
+        }\
+        for(j = 0;j < count;j++){\
+            slot = ___slice_function_name___(hash_prepare,name)(the_thing,keys[i + j],hashes[j],&found);\
+            if(slot == (size_t)-1){return 0;}\
+            if(!found){slice_unsafe_raw_storage_ptr(the_thing)[slot] = keys[i + j];}\
+        }\
+    }\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(find_n,name)(name* the_thing,const key_type* keys,size_t n,key_type** results){\
+    size_t slots[SLICE_HASH_BATCH];\
+    size_t i,j,count,found = 0;\
+    if(the_thing == NULL||the_thing->ctrl == NULL||keys == NULL||results == NULL){return 0;}\
+    for(i = 0;i < n;i += count){\
+        count = n - i < SLICE_HASH_BATCH ? n - i : SLICE_HASH_BATCH;\
+        ___slice_function_name___(hash_find_batch,name)(the_thing,keys + i,count,slots);\
+        for(j = 0;j < count;j++){\
+            if(slots[j] == slice_unsafe_raw_cap(the_thing)){results[i + j] = NULL;continue;}\
+            results[i + j] = slice_unsafe_raw_storage_ptr(the_thing) + slots[j];\
+            found++;\
+        }\
+    }\
+    return found;\
+} SLICE_C_END
+
+/*
+define_slice_hashset(name,key_type,HASH,EQ) creates a hash set named $name of key_type as described at the top of this file.
+*/
+#define define_slice_hashset(name,key_type,HASH,EQ) define_slice_hashset_decl(name,key_type);define_slice_hashset_definitions(name,key_type,HASH,EQ)
+
+
+
+#endif
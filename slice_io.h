@@ -0,0 +1,603 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_IO
+
+
+#define CUSTOM_SLICES_IO 1
+
+/*
+This file adds slices backed by files and binary snapshots of slices,
+it requires a POSIX system (mmap, ftruncate, msync, writev).
+Include it before any other header (or define _GNU_SOURCE on linux, _POSIX_C_SOURCE 200809L elsewhere, yourself)
+so the POSIX functions are declared even with -std=c99, and so growing a mapping on linux can use mremap,
+otherwise the mapping is unmapped and mapped again.
+*/
+#if defined(__linux__) && !defined(_GNU_SOURCE)
+#define _GNU_SOURCE 1
+#endif
+#if !defined(_POSIX_C_SOURCE) && !defined(_GNU_SOURCE)
+#define _POSIX_C_SOURCE 200809L
+#endif
+#include <sys/types.h>
+#include <sys/stat.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <stdint.h>
+#include <stddef.h>
+#include "slice.h"
+
+#ifndef SLICE_FD_VARAIABLE_NAME
+#define SLICE_FD_VARAIABLE_NAME fd
+#endif
+
+#ifndef SLICE_MODE_VARAIABLE_NAME
+#define SLICE_MODE_VARAIABLE_NAME mode
+#endif
+
+/*
+mmap slices also carry the file descriptor of their file and the mode it was opened with.
+*/
+#define slice_unsafe_raw_fd(slice_ptr) slice_ptr->SLICE_FD_VARAIABLE_NAME
+#define slice_unsafe_value_fd(slice_ptr) slice_ptr.SLICE_FD_VARAIABLE_NAME
+#define slice_unsafe_raw_mode(slice_ptr) slice_ptr->SLICE_MODE_VARAIABLE_NAME
+#define slice_unsafe_value_mode(slice_ptr) slice_ptr.SLICE_MODE_VARAIABLE_NAME
+
+
+/*
+Memory mapped slices.
+A mmap slice keeps its elements in a file mapped into memory with MAP_SHARED: opening is instant no matter how
+large the file is, pages are read on first use, and the page cache is shared with every other process mapping the file.
+The file holds the raw elements and nothing else, its size is length*sizeof(type) once the slice is destroyed.
+While the slice is open the file is grown with ftruncate to the capacity of the slice.
+Only use types without pointers, the file is reused by other runs and processes.
+
+For the remainder of this section, $name is the name of the custom type you definied, and $type
+is the type of an individual element in the container.
+define_slice_mmap(name,type) creates a mmap slice and the following functions:
+
+//$name $name_open_mmap(const char* path,int mode) maps the file at path, mode is one of
+//SLICE_MMAP_READ      the file must exist, the slice is read only (it can't grow and MUST NOT be written to)
+//SLICE_MMAP_WRITE     the file is created if it doesn't exist, its contents are kept
+//SLICE_MMAP_TRUNCATE  the file is created if it doesn't exist and emptied
+//check the result with $name_ok, when done with the slice you MUST call $name_destroy on it.
+$name $name_open_mmap(const char* path,int mode);
+
+//void $name_destroy($name* the_thing) unmaps the file, cuts it to the length of the slice (if writable) and closes it.
+void $name_destroy($name* the_thing);
+
+//int $name_sync($name* the_thing,int wait) writes the modified pages back to the file,
+//if wait is 0 the writes are only scheduled. returns 0 on failure and 1 on success.
+int $name_sync($name* the_thing,int wait);
+
+//int $name_advise($name* the_thing,int advice) tells the kernel how the slice will be read,
+//advice is one of SLICE_MMAP_NORMAL,SLICE_MMAP_SEQUENTIAL (read ahead aggressively),SLICE_MMAP_RANDOM (don't read ahead),
+//SLICE_MMAP_WILLNEED (start reading everything now) or SLICE_MMAP_DONTNEED (the pages may be dropped).
+//returns 0 on failure and 1 on success.
+int $name_advise($name* the_thing,int advice);
+
+It also has every function a slice created by define_slice(name,type) has except $name_make and $name_make_raw,
+$name_reserve/$name_grow/$name_shrink_to_fit change the size of the file and of the mapping.
+Growing may move the mapping, so pointers into the slice are invalidated like with regular slices.
+*/
+
+#define SLICE_MMAP_READ 0
+#define SLICE_MMAP_WRITE 1
+#define SLICE_MMAP_TRUNCATE 2
+
+#define SLICE_MMAP_NORMAL POSIX_MADV_NORMAL
+#define SLICE_MMAP_SEQUENTIAL POSIX_MADV_SEQUENTIAL
+#define SLICE_MMAP_RANDOM POSIX_MADV_RANDOM
+#define SLICE_MMAP_WILLNEED POSIX_MADV_WILLNEED
+#define SLICE_MMAP_DONTNEED POSIX_MADV_DONTNEED
+
+//the number of bytes mapped for a capacity of cap elements of size elem_size, at least 1 since empty mappings aren't allowed
+static inline size_t slice_mmap_bytes(size_t cap,size_t elem_size){
+    return cap == 0 ? 1 : cap*elem_size;
+}
+
+//maps bytes bytes of fd, returns NULL on failure
+static inline void* slice_mmap_map(int fd,size_t bytes,int writable){
+    void* out = mmap(NULL,bytes,writable ? PROT_READ|PROT_WRITE : PROT_READ,MAP_SHARED,fd,0);
+    return out == MAP_FAILED ? NULL : out;
+}
+
+//changes the size of the mapping of fd at old from old_bytes to new_bytes, returns NULL on failure (old is then still mapped)
+static inline void* slice_mmap_remap(void* old,size_t old_bytes,size_t new_bytes,int fd){
+#ifdef MREMAP_MAYMOVE
+    void* out = mremap(old,old_bytes,new_bytes,MREMAP_MAYMOVE);
+    (void)fd;
+    return out == MAP_FAILED ? NULL : out;
+#else
+    void* out = slice_mmap_map(fd,new_bytes,1);
+    if(out != NULL){munmap(old,old_bytes);}
+    return out;
+#endif
+}
+
+/*
+define_slice_mmap_struct creates a struct to act as a mmap slice type to hold objects of type $type,
+the name of the struct will be $name
+*/
+#define define_slice_mmap_struct(name,type) SLICE_C_BEGIN typedef struct name { type* SLICE_DATA_VARAIABLE_NAME; size_t SLICE_LENGTH_VARAIABLE_NAME;size_t SLICE_CAPACITY_VARAIABLE_NAME;int SLICE_FD_VARAIABLE_NAME;int SLICE_MODE_VARAIABLE_NAME;} name; SLICE_C_END
+
+/*
+define_slice_mmap_all_funct_decl(name,type) creates the declarations of every function of a mmap slice.
+*/
+#define define_slice_mmap_all_funct_decl(name,type) \
+SLICE_C_BEGIN name ___slice_function_name___(open_mmap,name)(const char* path,int mode); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(sync,name)(name* the_thing,int wait); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(advise,name)(name* the_thing,int advice); SLICE_C_END;\
+define_slice_destroy_decl(name,type);\
+define_slice_append_decl(name,type);\
+define_slice_front_append_decl(name,type);\
+define_slice_at_decl(name,type);\
+define_slice_set_decl(name,type);\
+define_slice_bounded_at_decl(name,type);\
+define_slice_bounded_set_decl(name,type);\
+define_slice_pop_decl(name,type);\
+define_slice_front_pop_decl(name,type);\
+define_slice_ok_decl(name,type);\
+define_slice_length_decl(name);\
+define_slice_cap_decl(name);\
+define_slice_resize_decl(name,type);\
+define_slice_append_n_decl(name,type);\
+define_slice_insert_n_decl(name,type);\
+define_slice_erase_range_decl(name,type);\
+define_slice_reserve_decl(name,type);\
+define_slice_grow_decl(name,type);\
+define_slice_shrink_to_fit_decl(name,type)
+
+/*
+$name $name_open_mmap(const char* path,int mode) opens and maps a file, see the note above.
+A writable slice starts with at least a page of capacity.
+*/
+#define define_slice_mmap_open(name,type) SLICE_C_BEGIN name ___slice_function_name___(open_mmap,name)(const char* path,int mode){\
+    name output;\
+    struct stat info;\
+    int writable = mode != SLICE_MMAP_READ;\
+    size_t cap;\
+    slice_unsafe_value_storage_ptr(output) = NULL;\
+    slice_unsafe_value_len(output) = 0;\
+    slice_unsafe_value_cap(output) = 0;\
+    slice_unsafe_value_mode(output) = mode;\
+    slice_unsafe_value_fd(output) = -1;\
+    if(path == NULL){return output;}\
+    slice_unsafe_value_fd(output) = open(path,writable ? O_RDWR|O_CREAT|(mode == SLICE_MMAP_TRUNCATE ? O_TRUNC : 0) : O_RDONLY,0644);\
+    if(slice_unsafe_value_fd(output) < 0){return output;}\
+    if(fstat(slice_unsafe_value_fd(output),&info) != 0||(uintmax_t)info.st_size > (uintmax_t)(size_t)-1){\
+        close(slice_unsafe_value_fd(output));\
+        slice_unsafe_value_fd(output) = -1;\
+        return output;\
+    }\
+    cap = (size_t)info.st_size/sizeof(type);\
+    slice_unsafe_value_len(output) = cap;\
+    if(writable && cap < SLICE_PAGE_SIZE/sizeof(type)){cap = SLICE_PAGE_SIZE/sizeof(type);}\
+    if(writable && cap < 1){cap = 1;}\
+    if((writable && (uintmax_t)cap*sizeof(type) > (uintmax_t)info.st_size && ftruncate(slice_unsafe_value_fd(output),(off_t)(cap*sizeof(type))) != 0)\
+        ||(slice_unsafe_value_storage_ptr(output) = (type*)slice_mmap_map(slice_unsafe_value_fd(output),slice_mmap_bytes(cap,sizeof(type)),writable)) == NULL){\
+        close(slice_unsafe_value_fd(output));\
+        slice_unsafe_value_fd(output) = -1;\
+        slice_unsafe_value_len(output) = 0;\
+        return output;\
+    }\
+    slice_unsafe_value_cap(output) = cap;\
+    return output;\
+} SLICE_C_END
+
+/*
+void $name_destroy($name* the_thing) unmaps the file, cuts it to the length of the slice (if writable) and closes it.
+*/
+#define define_slice_mmap_destroy(name,type) SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return;}\
+    munmap((void*)slice_unsafe_raw_storage_ptr(the_thing),slice_mmap_bytes(slice_unsafe_raw_cap(the_thing),sizeof(type)));\
+    if(slice_unsafe_raw_mode(the_thing) != SLICE_MMAP_READ){\
+        if(ftruncate(slice_unsafe_raw_fd(the_thing),(off_t)(slice_unsafe_raw_len(the_thing)*sizeof(type))) != 0){}\
+    }\
+    close(slice_unsafe_raw_fd(the_thing));\
+    slice_unsafe_raw_storage_ptr(the_thing) = NULL;\
+    slice_unsafe_raw_fd(the_thing) = -1;\
+    slice_unsafe_raw_len(the_thing) = 0;\
+    slice_unsafe_raw_cap(the_thing) = 0;\
+} SLICE_C_END
+
+/*
+int $name_reserve ($name* the_thing,size_t new_cap) makes sure the capacity of a mmap slice is at least new_cap,
+the file is grown first and the mapping follows it, returns 0 on failure (or if the slice is read only) and 1 on success.
+*/
+#define define_slice_mmap_reserve(name,type) SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    type* grown;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(new_cap <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(slice_unsafe_raw_mode(the_thing) == SLICE_MMAP_READ||new_cap > slice_max_cap(type)){return 0;}\
+    if(ftruncate(slice_unsafe_raw_fd(the_thing),(off_t)(new_cap*sizeof(type))) != 0){return 0;}\
+    grown = (type*)slice_mmap_remap((void*)slice_unsafe_raw_storage_ptr(the_thing),slice_mmap_bytes(slice_unsafe_raw_cap(the_thing),sizeof(type)),new_cap*sizeof(type),slice_unsafe_raw_fd(the_thing));\
+    if(grown == NULL){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing) = grown;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END
+
+/*
+int $name_shrink_to_fit ($name* the_thing) shrinks the mapping and the file to the length of the slice (at least 1 element),
+returns 0 on failure and 1 on success.
+*/
+#define define_slice_mmap_shrink_to_fit(name,type) SLICE_C_BEGIN int ___slice_function_name___(shrink_to_fit,name)(name* the_thing){\
+    type* shrunk;\
+    size_t new_cap;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    new_cap = slice_unsafe_raw_len(the_thing) == 0 ? 1 : slice_unsafe_raw_len(the_thing);\
+    if(slice_unsafe_raw_mode(the_thing) == SLICE_MMAP_READ||new_cap >= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    shrunk = (type*)slice_mmap_remap((void*)slice_unsafe_raw_storage_ptr(the_thing),slice_mmap_bytes(slice_unsafe_raw_cap(the_thing),sizeof(type)),new_cap*sizeof(type),slice_unsafe_raw_fd(the_thing));\
+    if(shrunk == NULL){return 0;}\
+    slice_unsafe_raw_storage_ptr(the_thing) = shrunk;\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return ftruncate(slice_unsafe_raw_fd(the_thing),(off_t)(new_cap*sizeof(type))) == 0;\
+} SLICE_C_END
+
+/*
+int $name_sync($name* the_thing,int wait) writes the modified pages of a mmap slice back to its file.
+*/
+#define define_slice_mmap_sync(name,type) SLICE_C_BEGIN int ___slice_function_name___(sync,name)(name* the_thing,int wait){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(slice_unsafe_raw_mode(the_thing) == SLICE_MMAP_READ||slice_unsafe_raw_len(the_thing) == 0){return 1;}\
+    return msync((void*)slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing)*sizeof(type),wait ? MS_SYNC : MS_ASYNC) == 0;\
+} SLICE_C_END
+
+/*
+int $name_advise($name* the_thing,int advice) passes an access pattern hint for the mapping of a mmap slice to the kernel.
+*/
+#define define_slice_mmap_advise(name,type) SLICE_C_BEGIN int ___slice_function_name___(advise,name)(name* the_thing,int advice){\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    return posix_madvise((void*)slice_unsafe_raw_storage_ptr(the_thing),slice_mmap_bytes(slice_unsafe_raw_cap(the_thing),sizeof(type)),advice) == 0;\
+} SLICE_C_END
+
+/*
+define_slice_mmap_declarations(name,type) creates a mmap slice named $name for $type and the declarations of its functions.
+*/
+#define define_slice_mmap_declarations(name,type) define_slice_mmap_struct(name,type);define_slice_mmap_all_funct_decl(name,type);define_slice_view_decl(name,type)
+
+/*
+define_slice_mmap_definitions(name,type) creates all the function definitions to use a mmap slice.
+define_slice_mmap_declarations MUST be user prior to this with the same name and type (if not then at least define_slice_mmap_struct).
+*/
+#define define_slice_mmap_definitions(name,type) define_slice_stats(name,type)\
+define_slice_mmap_open(name,type);\
+define_slice_mmap_destroy(name,type);\
+define_slice_mmap_sync(name,type);\
+define_slice_mmap_advise(name,type);\
+define_slice_append(name,type);\
+define_slice_front_append(name,type);\
+define_slice_at(name,type);\
+define_slice_set(name,type);\
+define_slice_bounded_at(name,type);\
+define_slice_bounded_set(name,type);\
+define_slice_pop(name,type);\
+define_slice_front_pop(name,type);\
+define_slice_ok(name,type);\
+define_slice_length(name);\
+define_slice_cap(name);\
+define_slice_resize(name,type);\
+define_slice_append_n(name,type);\
+define_slice_insert_n(name,type);\
+define_slice_erase_range(name,type);\
+define_slice_mmap_reserve(name,type);\
+define_slice_grow(name,type);\
+define_slice_mmap_shrink_to_fit(name,type);\
+define_slice_view_definitions(name,type)
+
+/*
+define_slice_mmap(name,type) creates a mmap slice named $name to act as a dynamic array container for $type
+that lives in a file, as described above.
+If you wish to seperate the functions from the declearations you may use
+define_slice_mmap_declarations(name,type) and define_slice_mmap_definitions(name,type).
+*/
+#define define_slice_mmap(name,type) define_slice_mmap_declarations(name,type);define_slice_mmap_definitions(name,type)
+
+
+/*
+Snapshots.
+A snapshot is a binary copy of a slice that can be written to and read back from any file descriptor,
+for slices of types without pointers (the bytes of the elements are written as they are in memory).
+A snapshot is a header page followed by the elements, padded with zeros to a multiple of SLICE_PAGE_SIZE:
+the header holds a magic string, a format version, the byte order, the size of an element, the length,
+a checksum of the elements and a checksum of the header itself.
+Since the elements start on a page boundary (if the snapshot starts on one, snapshots written one after the other
+in a file all do), a snapshot in a file can be mapped back read only with mmap instead of being copied.
+
+After defining a slice (or any slice variant with contiguous storage) with define_slice(name,type), use
+define_slice_snapshot(name,type)
+to create the following functions:
+
+//int $name_write_to_fd($name* the_thing,int fd) writes a snapshot of the slice at the current position of fd,
+//returns 0 on failure and 1 on success.
+int $name_write_to_fd($name* the_thing,int fd);
+
+//int $name_read_from_fd($name* the_thing,int fd) replaces the contents of the slice with the snapshot at the current position
+//of fd (which is left after the snapshot), returns 0 if it couldn't be read or isn't a valid snapshot of $type
+//(the slice may then hold part of the elements) and 1 on success.
+int $name_read_from_fd($name* the_thing,int fd);
+
+//slice_snapshot_part $name_snapshot_part($name* the_thing) describes the slice for slice_write_snapshots.
+slice_snapshot_part $name_snapshot_part($name* the_thing);
+
+//int $name_map_from_fd(int fd,off_t offset,int verify,slice_snapshot_mapping* out) maps the snapshot of $type starting at offset
+//(a multiple of SLICE_PAGE_SIZE) read only, out->data then points to out->len elements. If verify is not 0 the checksum
+//of the elements is checked, which reads every page. returns 0 on failure (also if the file is shorter than the header says) and 1 on success,
+//a mapping MUST be released with slice_snapshot_unmap.
+int $name_map_from_fd(int fd,off_t offset,int verify,slice_snapshot_mapping* out);
+
+Several slices (of any types) are written with a single writev call by
+slice_write_snapshots(fd,parts,count), parts being an array of $name_snapshot_part results.
+They are read back in the same order with $name_read_from_fd.
+Snapshots use the byte order and type layout of the machine that wrote them,
+reading a snapshot written with another byte order or element size fails.
+*/
+
+#include <sys/uio.h>
+#include <limits.h>
+
+#define SLICE_SNAPSHOT_VERSION 1
+#define SLICE_SNAPSHOT_MAGIC "SLICESNP"
+#define SLICE_SNAPSHOT_BYTE_ORDER 0x0102030405060708ull
+
+#ifndef SLICE_IOV_MAX
+#ifdef IOV_MAX
+//the largest number of buffers passed to one writev call
+#define SLICE_IOV_MAX IOV_MAX
+#else
+#define SLICE_IOV_MAX 1024
+#endif
+#endif
+
+//the header at the start of a snapshot, the elements start header_size bytes after it
+typedef struct slice_snapshot_header{
+    char magic[8];
+    uint32_t version;
+    uint32_t header_size;
+    uint64_t byte_order;
+    uint64_t elem_size;
+    uint64_t len;
+    uint64_t checksum;
+    uint64_t header_checksum;
+    uint64_t reserved;
+} slice_snapshot_header;
+
+//a slice to be written by slice_write_snapshots
+typedef struct slice_snapshot_part{
+    const void* data;
+    size_t len;
+    size_t elem_size;
+} slice_snapshot_part;
+
+//a snapshot mapped by $name_map_from_fd, data points to len elements
+typedef struct slice_snapshot_mapping{
+    const void* data;
+    size_t len;
+    void* base;
+    size_t bytes;
+} slice_snapshot_mapping;
+
+/*
+uint64_t slice_checksum(const void* data,size_t bytes) is the checksum stored in snapshots,
+it reads 32 bytes per step into 4 independent multiply-rotate lanes so it keeps up with the disk.
+*/
+static inline uint64_t slice_checksum(const void* data,size_t bytes){
+    const unsigned char* in = (const unsigned char*)data;
+    const uint64_t prime = 0x9E3779B97F4A7C15ull;
+    uint64_t lanes[4] = {prime,prime*3,prime*5,prime*7},word,out;
+    size_t i,j;
+    for(i = 0;i + 32 <= bytes;i += 32){
+        for(j = 0;j < 4;j++){
+            memcpy(&word,in + i + 8*j,8);
+            lanes[j] = (lanes[j] ^ word)*prime;
+            lanes[j] = (lanes[j] << 31)|(lanes[j] >> 33);
+        }
+    }
+    out = (uint64_t)bytes;
+    for(j = 0;j < 4;j++){out = (out ^ lanes[j])*prime;}
+    for(;i < bytes;i++){out = (out ^ in[i])*prime;}
+    return out ^ (out >> 29);
+}
+
+//the number of bytes of zeros written after n bytes of elements so the next snapshot starts on a page
+static inline size_t slice_snapshot_padding(size_t payload_bytes){
+    return (SLICE_PAGE_SIZE - payload_bytes % SLICE_PAGE_SIZE) % SLICE_PAGE_SIZE;
+}
+
+//fills a header for len elements of elem_size bytes at data
+static inline void slice_snapshot_make_header(slice_snapshot_header* header,const void* data,size_t len,size_t elem_size){
+    memset(header,0,sizeof(*header));
+    memcpy(header->magic,SLICE_SNAPSHOT_MAGIC,8);
+    header->version = SLICE_SNAPSHOT_VERSION;
+    header->header_size = SLICE_PAGE_SIZE;
+    header->byte_order = SLICE_SNAPSHOT_BYTE_ORDER;
+    header->elem_size = elem_size;
+    header->len = len;
+    header->checksum = len == 0 ? slice_checksum(NULL,0) : slice_checksum(data,len*elem_size);
+    header->header_checksum = slice_checksum(header,offsetof(slice_snapshot_header,header_checksum));
+}
+
+//returns 1 if header is a valid snapshot header for elements of elem_size bytes, 0 otherwise
+static inline int slice_snapshot_check_header(const slice_snapshot_header* header,size_t elem_size){
+    return memcmp(header->magic,SLICE_SNAPSHOT_MAGIC,8) == 0
+        && header->version == SLICE_SNAPSHOT_VERSION
+        && header->header_checksum == slice_checksum(header,offsetof(slice_snapshot_header,header_checksum))
+        && header->byte_order == SLICE_SNAPSHOT_BYTE_ORDER
+        && header->header_size >= sizeof(slice_snapshot_header)
+        && header->elem_size == elem_size
+        && header->len <= ((size_t)-1)/elem_size;
+}
+
+//writes every buffer of iov to fd with as few writev calls as possible, retrying partial writes. returns 0 on failure and 1 on success
+static inline int slice_writev_all(int fd,struct iovec* iov,size_t count){
+    while(count > 0){
+        ssize_t written = writev(fd,iov,(int)(count < SLICE_IOV_MAX ? count : SLICE_IOV_MAX));
+        if(written < 0){return 0;}
+        while(count > 0 && (size_t)written >= iov->iov_len){
+            written -= (ssize_t)iov->iov_len;
+            iov++;
+            count--;
+        }
+        if(count > 0){
+            iov->iov_base = (char*)iov->iov_base + written;
+            iov->iov_len -= (size_t)written;
+        }
+    }
+    return 1;
+}
+
+//reads exactly bytes bytes from fd, returns 0 on failure or early end of file and 1 on success
+static inline int slice_read_all(int fd,void* data,size_t bytes){
+    char* out = (char*)data;
+    while(bytes > 0){
+        ssize_t got = read(fd,out,bytes);
+        if(got <= 0){return 0;}
+        out += got;
+        bytes -= (size_t)got;
+    }
+    return 1;
+}
+
+//reads and drops bytes bytes from fd, returns 0 on failure or early end of file and 1 on success
+static inline int slice_skip_all(int fd,size_t bytes){
+    char skipped[512];
+    while(bytes > 0){
+        size_t chunk = bytes < sizeof(skipped) ? bytes : sizeof(skipped);
+        if(!slice_read_all(fd,skipped,chunk)){return 0;}
+        bytes -= chunk;
+    }
+    return 1;
+}
+
+/*
+int slice_write_snapshots(int fd,const slice_snapshot_part* parts,size_t count) writes a snapshot of each part
+one after the other with writev, returns 0 on failure and 1 on success.
+*/
+static inline int slice_write_snapshots(int fd,const slice_snapshot_part* parts,size_t count){
+    struct iovec* iov;
+    char* pages;
+    size_t i;
+    int ok;
+    if(parts == NULL && count != 0){return 0;}
+    if(count == 0){return 1;}
+    if(count > ((size_t)-1)/SLICE_PAGE_SIZE - 1||count > ((size_t)-1)/(3*sizeof(struct iovec))){return 0;}
+    //one header page per part and a zero page for the padding
+    pages = slice_calloc(char,(count + 1)*SLICE_PAGE_SIZE);
+    iov = slice_calloc(struct iovec,3*count);
+    if(slice_alloc_failed(pages)||slice_alloc_failed(iov)){
+        slice_free(pages);
+        slice_free(iov);
+        return 0;
+    }
+    for(i = 0;i < count;i++){
+        size_t bytes = parts[i].len*parts[i].elem_size;
+        slice_snapshot_make_header((slice_snapshot_header*)(pages + (i + 1)*SLICE_PAGE_SIZE),parts[i].data,parts[i].len,parts[i].elem_size);
+        iov[3*i].iov_base = pages + (i + 1)*SLICE_PAGE_SIZE;
+        iov[3*i].iov_len = SLICE_PAGE_SIZE;
+        iov[3*i + 1].iov_base = (void*)parts[i].data;
+        iov[3*i + 1].iov_len = bytes;
+        iov[3*i + 2].iov_base = pages;
+        iov[3*i + 2].iov_len = slice_snapshot_padding(bytes);
+    }
+    ok = slice_writev_all(fd,iov,3*count);
+    slice_free(pages);
+    slice_free(iov);
+    return ok;
+}
+
+/*
+void slice_snapshot_unmap(slice_snapshot_mapping* mapping) releases a mapping made by $name_map_from_fd.
+*/
+static inline void slice_snapshot_unmap(slice_snapshot_mapping* mapping){
+    if(mapping == NULL||mapping->base == NULL){return;}
+    munmap(mapping->base,mapping->bytes);
+    memset(mapping,0,sizeof(*mapping));
+}
+
+//maps the snapshot of elements of elem_size bytes at offset of fd, see $name_map_from_fd
+static inline int slice_snapshot_map(int fd,off_t offset,size_t elem_size,int verify,slice_snapshot_mapping* out){
+    slice_snapshot_header header;
+    struct stat st;
+    off_t start,page;
+    size_t bytes,skip;
+    void* base;
+    if(out == NULL||offset < 0){return 0;}
+    memset(out,0,sizeof(*out));
+    if(pread(fd,&header,sizeof(header),offset) != (ssize_t)sizeof(header)||!slice_snapshot_check_header(&header,elem_size)){return 0;}
+    bytes = (size_t)header.len*elem_size;
+    //the elements must lie inside the file, touching a mapped page past its end raises SIGBUS instead of failing here
+    if(fstat(fd,&st) != 0||st.st_size < offset){return 0;}
+    if((uint64_t)header.header_size > (uint64_t)(st.st_size - offset)){return 0;}
+    if((uint64_t)bytes > (uint64_t)(st.st_size - offset) - header.header_size){return 0;}
+    //mmap offsets must be a multiple of the real page size, which may be larger than SLICE_PAGE_SIZE
+    page = (off_t)sysconf(_SC_PAGESIZE);
+    start = offset + (off_t)header.header_size;
+    skip = page > 0 ? (size_t)(start % page) : 0;
+    if(bytes > ((size_t)-1) - skip - 1){return 0;}
+    base = mmap(NULL,skip + bytes + 1,PROT_READ,MAP_SHARED,fd,start - (off_t)skip);
+    if(base == MAP_FAILED){return 0;}
+    out->base = base;
+    out->bytes = skip + bytes + 1;
+    out->data = (const char*)base + skip;
+    out->len = (size_t)header.len;
+    if(verify && slice_checksum(out->data,bytes) != header.checksum){
+        slice_snapshot_unmap(out);
+        return 0;
+    }
+    return 1;
+}
+
+/*
+define_slice_snapshot_decl(name,type) creates the declarations of the functions of define_slice_snapshot.
+*/
+#define define_slice_snapshot_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(write_to_fd,name)(name* the_thing,int fd); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(read_from_fd,name)(name* the_thing,int fd); SLICE_C_END;\
+SLICE_C_BEGIN slice_snapshot_part ___slice_function_name___(snapshot_part,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(map_from_fd,name)(int fd,off_t offset,int verify,slice_snapshot_mapping* out); SLICE_C_END
+
+/*
+define_slice_snapshot_definitions(name,type) creates the definitions of the functions of define_slice_snapshot,
+$name_read_from_fd uses $name_resize to make room for the elements.
+*/
+#define define_slice_snapshot_definitions(name,type) \
+SLICE_C_BEGIN slice_snapshot_part ___slice_function_name___(snapshot_part,name)(name* the_thing){\
+    slice_snapshot_part part;\
+    part.data = the_thing == NULL ? NULL : (const void*)slice_unsafe_raw_storage_ptr(the_thing);\
+    part.len = the_thing == NULL ? 0 : slice_unsafe_raw_len(the_thing);\
+    part.elem_size = sizeof(type);\
+    return part;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(write_to_fd,name)(name* the_thing,int fd){\
+    slice_snapshot_part part;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    part = ___slice_function_name___(snapshot_part,name)(the_thing);\
+    return slice_write_snapshots(fd,&part,1);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(read_from_fd,name)(name* the_thing,int fd){\
+    slice_snapshot_header header;\
+    size_t bytes;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL){return 0;}\
+    if(!slice_read_all(fd,&header,sizeof(header))||!slice_snapshot_check_header(&header,sizeof(type))){return 0;}\
+    if(!slice_skip_all(fd,header.header_size - sizeof(header))){return 0;}\
+    if(!___slice_function_name___(resize,name)(the_thing,(size_t)header.len)){return 0;}\
+    bytes = (size_t)header.len*sizeof(type);\
+    if(!slice_read_all(fd,slice_unsafe_raw_storage_ptr(the_thing),bytes)||!slice_skip_all(fd,slice_snapshot_padding(bytes))){return 0;}\
+    return slice_checksum(slice_unsafe_raw_storage_ptr(the_thing),bytes) == header.checksum;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(map_from_fd,name)(int fd,off_t offset,int verify,slice_snapshot_mapping* out){\
+    return slice_snapshot_map(fd,offset,sizeof(type),verify,out);\
+} SLICE_C_END
+
+/*
+define_slice_snapshot(name,type) creates the snapshot functions described above for the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_snapshot(name,type) define_slice_snapshot_decl(name,type);define_slice_snapshot_definitions(name,type)
+
+
+
+
+#endif
@@ -0,0 +1,351 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_SIMD
+
+
+#define CUSTOM_SLICES_SIMD 1
+#include "slice.h"
+
+/*
+This file adds search, count, fill, min/max and sum functions for slices of arithmetic types
+(char,short,int,long,float,double,uint8_t,int32_t,...).
+
+For the remainder of this section, $name is the name of the custom type you definied, and $type
+is the type of an individual element in the container.
+After defining a slice with define_slice(name,type) (or define_slice_with_allocator, define_slice_mmap), use
+define_slice_simd_ops(name,type)
+to create the following functions:
+
+//int $name_find($name* the_thing,type value,size_t* index) looks for the first element equal to value,
+//returns 1 and fills index (if not NULL) if it is found, 0 otherwise.
+int $name_find($name* the_thing,type value,size_t* index);
+
+//size_t $name_count($name* the_thing,type value) returns the number of elements equal to value.
+size_t $name_count($name* the_thing,type value);
+
+//void $name_fill($name* the_thing,type value) sets every element of the slice to value.
+void $name_fill($name* the_thing,type value);
+
+//int $name_min($name* the_thing,type* result) / int $name_max($name* the_thing,type* result) put the smallest/largest
+//element into result, returns 1 on success and 0 if the slice is empty.
+int $name_min($name* the_thing,type* result);
+int $name_max($name* the_thing,type* result);
+
+//type $name_sum($name* the_thing) returns the sum of the elements, computed in $type
+//(integer sums wrap like $type does, floating point sums are added in a different order than a plain loop).
+type $name_sum($name* the_thing);
+
+Each function also exists as $name_find_ptr,$name_count_ptr,... taking (const type* data,size_t len,...) instead of a slice,
+and as $name_view_find,$name_view_count,... taking a $name_view instead of a slice.
+
+With GCC or clang on x86 the functions are compiled for SSE2, AVX2 and AVX-512 and the best one the cpu supports
+is picked at runtime, otherwise (or if SLICE_SIMD_MAX_LEVEL is defined to 0) a scalar loop is used.
+You may cap the instruction sets used by defining SLICE_SIMD_MAX_LEVEL to
+SLICE_SIMD_SCALAR, SLICE_SIMD_SSE2, SLICE_SIMD_AVX2 or SLICE_SIMD_AVX512.
+*/
+
+#define SLICE_SIMD_SCALAR 0
+#define SLICE_SIMD_SSE2 1
+#define SLICE_SIMD_AVX2 2
+#define SLICE_SIMD_AVX512 3
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#define SLICE_SIMD_X86 1
+#endif
+
+#ifndef SLICE_SIMD_MAX_LEVEL
+#ifdef SLICE_SIMD_X86
+#define SLICE_SIMD_MAX_LEVEL SLICE_SIMD_AVX512
+#else
+#define SLICE_SIMD_MAX_LEVEL SLICE_SIMD_SCALAR
+#endif
+#endif
+
+//returns the best instruction set of this cpu, capped by SLICE_SIMD_MAX_LEVEL,
+//the cpu is only queried by the first call, later calls return the cached level.
+static inline int slice_simd_level(void){
+#ifdef SLICE_SIMD_X86
+    static int cached = 0; //level + 1, 0 until the cpu was queried
+    int level = __atomic_load_n(&cached,__ATOMIC_RELAXED);
+    if(level != 0){return level - 1;}
+    level = SLICE_SIMD_SCALAR;
+    if(SLICE_SIMD_MAX_LEVEL >= SLICE_SIMD_AVX512 && __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw")){level = SLICE_SIMD_AVX512;}
+    else if(SLICE_SIMD_MAX_LEVEL >= SLICE_SIMD_AVX2 && __builtin_cpu_supports("avx2")){level = SLICE_SIMD_AVX2;}
+    else if(SLICE_SIMD_MAX_LEVEL >= SLICE_SIMD_SSE2 && __builtin_cpu_supports("sse2")){level = SLICE_SIMD_SSE2;}
+    __atomic_store_n(&cached,level + 1,__ATOMIC_RELAXED);
+    return level;
+#else
+    return SLICE_SIMD_SCALAR;
+#endif
+}
+
+/*
+___slice_simd_scalar_kernels___(name,type) creates the scalar kernels, not meant to be used outside this file.
+*/
+#define ___slice_simd_scalar_kernels___(name,type) \
+static int ___slice_function_name___(find_scalar,name)(const type* data,size_t len,type value,size_t start,size_t* index){\
+    size_t i;\
+    for(i = start;i < len;i++){if(data[i] == value){*index = i;return 1;}}\
+    return 0;\
+}\
+static size_t ___slice_function_name___(count_scalar,name)(const type* data,size_t len,type value,size_t start){\
+    size_t i,out = 0;\
+    for(i = start;i < len;i++){out += data[i] == value;}\
+    return out;\
+}\
+static type ___slice_function_name___(min_scalar,name)(const type* data,size_t len,type acc,size_t start){\
+    size_t i;\
+    for(i = start;i < len;i++){if(data[i] < acc){acc = data[i];}}\
+    return acc;\
+}\
+static type ___slice_function_name___(max_scalar,name)(const type* data,size_t len,type acc,size_t start){\
+    size_t i;\
+    for(i = start;i < len;i++){if(data[i] > acc){acc = data[i];}}\
+    return acc;\
+}\
+static type ___slice_function_name___(sum_scalar,name)(const type* data,size_t len,type acc,size_t start){\
+    size_t i;\
+    for(i = start;i < len;i++){acc += data[i];}\
+    return acc;\
+}\
+static void ___slice_function_name___(fill_scalar,name)(type* data,size_t len,type value,size_t start){\
+    size_t i;\
+    for(i = start;i < len;i++){data[i] = value;}\
+}
+
+#ifdef SLICE_SIMD_X86
+/*
+___slice_simd_kernels___(name,type,W,TARGET,suffix) creates the kernels working on W byte vectors compiled for TARGET,
+not meant to be used outside this file.
+Vectors are GCC vector extensions, comparisons give a mask vector (all bits set for true) that is used to
+count (subtracting the mask) and to select (and/or with the mask).
+The count accumulator is flushed every 127 vectors so the lanes never overflow, even for 1 byte types.
+*/
+#define ___slice_simd_kernels___(name,type,W,TARGET,suffix) \
+__attribute__((target(TARGET))) static int ___slice_function_name___(find_##suffix,name)(const type* data,size_t len,type value,size_t* index){\
+    typedef type vec __attribute__((vector_size(W)));\
+    typedef unsigned long long words __attribute__((vector_size(W)));\
+    const size_t lanes = W/sizeof(type);\
+    size_t i,j;\
+    vec needle,x;\
+    words hit;\
+    for(j = 0;j < lanes;j++){needle[j] = value;}\
+    for(i = 0;i + lanes <= len;i += lanes){\
+        SLICE_UNSAFE_MEMCPY(&x,data + i,W);\
+        hit = (words)(x == needle);\
+        for(j = 0;j < W/sizeof(unsigned long long);j++){\
+            if(hit[j]){return ___slice_function_name___(find_scalar,name)(data,i + lanes,value,i,index);}\
+        }\
+    }\
+    return ___slice_function_name___(find_scalar,name)(data,len,value,i,index);\
+}\
+__attribute__((target(TARGET))) static size_t ___slice_function_name___(count_##suffix,name)(const type* data,size_t len,type value){\
+    typedef type vec __attribute__((vector_size(W)));\
+    const size_t lanes = W/sizeof(type);\
+    size_t i = 0,j,block,out = 0;\
+    vec needle,x;\
+    for(j = 0;j < lanes;j++){needle[j] = value;}\
+    while(i + lanes <= len){\
+        __typeof__(needle == needle) acc;\
+        SLICE_UNSAFE_MEMSET(&acc,0,sizeof(acc));\
+        for(block = 0;block < 127 && i + lanes <= len;block++,i += lanes){\
+            SLICE_UNSAFE_MEMCPY(&x,data + i,W);\
+            acc -= x == needle;\
+        }\
+        for(j = 0;j < lanes;j++){out += (size_t)(unsigned char)acc[j];}\
+    }\
+    return out + ___slice_function_name___(count_scalar,name)(data,len,value,i);\
+}\
+__attribute__((target(TARGET))) static type ___slice_function_name___(min_##suffix,name)(const type* data,size_t len){\
+    typedef type vec __attribute__((vector_size(W)));\
+    const size_t lanes = W/sizeof(type);\
+    size_t i,j;\
+    vec acc,x;\
+    type out;\
+    if(len < lanes){return ___slice_function_name___(min_scalar,name)(data,len,data[0],1);}\
+    SLICE_UNSAFE_MEMCPY(&acc,data,W);\
+    for(i = lanes;i + lanes <= len;i += lanes){\
+        SLICE_UNSAFE_MEMCPY(&x,data + i,W);\
+        __typeof__(x < acc) take = x < acc;\
+        acc = (vec)(((__typeof__(take))x & take) | ((__typeof__(take))acc & ~take));\
+    }\
+    out = acc[0];\
+    for(j = 1;j < lanes;j++){if(acc[j] < out){out = acc[j];}}\
+    return ___slice_function_name___(min_scalar,name)(data,len,out,i);\
+}\
+__attribute__((target(TARGET))) static type ___slice_function_name___(max_##suffix,name)(const type* data,size_t len){\
+    typedef type vec __attribute__((vector_size(W)));\
+    const size_t lanes = W/sizeof(type);\
+    size_t i,j;\
+    vec acc,x;\
+    type out;\
+    if(len < lanes){return ___slice_function_name___(max_scalar,name)(data,len,data[0],1);}\
+    SLICE_UNSAFE_MEMCPY(&acc,data,W);\
+    for(i = lanes;i + lanes <= len;i += lanes){\
+        SLICE_UNSAFE_MEMCPY(&x,data + i,W);\
+        __typeof__(x > acc) take = x > acc;\
+        acc = (vec)(((__typeof__(take))x & take) | ((__typeof__(take))acc & ~take));\
+    }\
+    out = acc[0];\
+    for(j = 1;j < lanes;j++){if(acc[j] > out){out = acc[j];}}\
+    return ___slice_function_name___(max_scalar,name)(data,len,out,i);\
+}\
+__attribute__((target(TARGET))) static type ___slice_function_name___(sum_##suffix,name)(const type* data,size_t len){\
+    typedef type vec __attribute__((vector_size(W)));\
+    const size_t lanes = W/sizeof(type);\
+    size_t i,j;\
+    vec acc,x;\
+    type out = 0;\
+    for(j = 0;j < lanes;j++){acc[j] = 0;}\
+    for(i = 0;i + lanes <= len;i += lanes){\
+        SLICE_UNSAFE_MEMCPY(&x,data + i,W);\
+        acc += x;\
+    }\
+    for(j = 0;j < lanes;j++){out += acc[j];}\
+    return ___slice_function_name___(sum_scalar,name)(data,len,out,i);\
+}\
+__attribute__((target(TARGET))) static void ___slice_function_name___(fill_##suffix,name)(type* data,size_t len,type value){\
+    typedef type vec __attribute__((vector_size(W)));\
+    const size_t lanes = W/sizeof(type);\
+    size_t i,j;\
+    vec splat;\
+    for(j = 0;j < lanes;j++){splat[j] = value;}\
+    for(i = 0;i + lanes <= len;i += lanes){SLICE_UNSAFE_MEMCPY(data + i,&splat,W);}\
+    ___slice_function_name___(fill_scalar,name)(data,len,value,i);\
+}
+
+/*
+___slice_simd_dispatch___(name,kernel,args,before,after) runs "before kernel args; after" with the kernel of the
+instruction set picked by slice_simd_level(), not meant to be used outside this file.
+*/
+#define ___slice_simd_dispatch___(name,kernel,args,before,after) \
+    switch(slice_simd_level()){\
+        case SLICE_SIMD_AVX512: before ___slice_function_name___(kernel##_avx512,name) args; after\
+        case SLICE_SIMD_AVX2: before ___slice_function_name___(kernel##_avx2,name) args; after\
+        case SLICE_SIMD_SSE2: before ___slice_function_name___(kernel##_sse2,name) args; after\
+        default: break;\
+    }
+
+#define ___slice_simd_all_kernels___(name,type) ___slice_simd_scalar_kernels___(name,type)\
+___slice_simd_kernels___(name,type,16,"sse2",sse2)\
+___slice_simd_kernels___(name,type,32,"avx2",avx2)\
+___slice_simd_kernels___(name,type,64,"avx512f,avx512bw",avx512)
+#else
+#define ___slice_simd_dispatch___(name,kernel,args,before,after)
+#define ___slice_simd_all_kernels___(name,type) ___slice_simd_scalar_kernels___(name,type)
+#endif
+
+/*
+define_slice_simd_ops_decl(name,type) creates the declarations of the functions of define_slice_simd_ops.
+*/
+#define define_slice_simd_ops_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(find_ptr,name)(const type* data,size_t len,type value,size_t* index); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(count_ptr,name)(const type* data,size_t len,type value); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(fill_ptr,name)(type* data,size_t len,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(min_ptr,name)(const type* data,size_t len,type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(max_ptr,name)(const type* data,size_t len,type* result); SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(sum_ptr,name)(const type* data,size_t len); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(find,name)(name* the_thing,type value,size_t* index); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(count,name)(name* the_thing,type value); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(fill,name)(name* the_thing,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(min,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(max,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(sum,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_find,name)(___slice_function_name___(view,name) view,type value,size_t* index); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(view_count,name)(___slice_function_name___(view,name) view,type value); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(view_fill,name)(___slice_function_name___(view,name) view,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_min,name)(___slice_function_name___(view,name) view,type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_max,name)(___slice_function_name___(view,name) view,type* result); SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(view_sum,name)(___slice_function_name___(view,name) view); SLICE_C_END
+
+/*
+define_slice_simd_ops_definitions(name,type) creates the definitions of the functions of define_slice_simd_ops.
+*/
+#define define_slice_simd_ops_definitions(name,type) ___slice_simd_all_kernels___(name,type)\
+SLICE_C_BEGIN int ___slice_function_name___(find_ptr,name)(const type* data,size_t len,type value,size_t* index){\
+    size_t ignored;\
+    if(data == NULL){return 0;}\
+    if(index == NULL){index = &ignored;}\
+    ___slice_simd_dispatch___(name,find,(data,len,value,index),return,)\
+    return ___slice_function_name___(find_scalar,name)(data,len,value,0,index);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(count_ptr,name)(const type* data,size_t len,type value){\
+    if(data == NULL){return 0;}\
+    ___slice_simd_dispatch___(name,count,(data,len,value),return,)\
+    return ___slice_function_name___(count_scalar,name)(data,len,value,0);\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(fill_ptr,name)(type* data,size_t len,type value){\
+    if(data == NULL){return;}\
+    ___slice_simd_dispatch___(name,fill,(data,len,value),,return;)\
+    ___slice_function_name___(fill_scalar,name)(data,len,value,0);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(min_ptr,name)(const type* data,size_t len,type* result){\
+    if(data == NULL||result == NULL||len == 0){return 0;}\
+    ___slice_simd_dispatch___(name,min,(data,len),*result =,return 1;)\
+    *result = ___slice_function_name___(min_scalar,name)(data,len,data[0],1);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(max_ptr,name)(const type* data,size_t len,type* result){\
+    if(data == NULL||result == NULL||len == 0){return 0;}\
+    ___slice_simd_dispatch___(name,max,(data,len),*result =,return 1;)\
+    *result = ___slice_function_name___(max_scalar,name)(data,len,data[0],1);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(sum_ptr,name)(const type* data,size_t len){\
+    if(data == NULL){return 0;}\
+    ___slice_simd_dispatch___(name,sum,(data,len),return,)\
+    return ___slice_function_name___(sum_scalar,name)(data,len,0,0);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(find,name)(name* the_thing,type value,size_t* index){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(find_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),value,index);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(count,name)(name* the_thing,type value){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(count_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(fill,name)(name* the_thing,type value){\
+    if(the_thing == NULL){return;}\
+    ___slice_function_name___(fill_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(min,name)(name* the_thing,type* result){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(min_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),result);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(max,name)(name* the_thing,type* result){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(max_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),result);\
+} SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(sum,name)(name* the_thing){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(sum_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_find,name)(___slice_function_name___(view,name) view,type value,size_t* index){\
+    return ___slice_function_name___(find_ptr,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),value,index);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(view_count,name)(___slice_function_name___(view,name) view,type value){\
+    return ___slice_function_name___(count_ptr,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(view_fill,name)(___slice_function_name___(view,name) view,type value){\
+    ___slice_function_name___(fill_ptr,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_min,name)(___slice_function_name___(view,name) view,type* result){\
+    return ___slice_function_name___(min_ptr,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),result);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_max,name)(___slice_function_name___(view,name) view,type* result){\
+    return ___slice_function_name___(max_ptr,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),result);\
+} SLICE_C_END;\
+SLICE_C_BEGIN type ___slice_function_name___(view_sum,name)(___slice_function_name___(view,name) view){\
+    return ___slice_function_name___(sum_ptr,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view));\
+} SLICE_C_END
+
+/*
+define_slice_simd_ops(name,type) creates the find/count/fill/min/max/sum functions described at the top of this file
+for the slice $name of $type, the slice must have been defined before.
+*/
+#define define_slice_simd_ops(name,type) define_slice_simd_ops_decl(name,type);define_slice_simd_ops_definitions(name,type)
+
+
+
+#endif
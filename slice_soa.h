@@ -0,0 +1,248 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_SOA
+
+
+#define CUSTOM_SLICES_SOA 1
+#include "slice.h"
+
+/*
+This file adds structure of arrays slices, a slice of records that keeps each field of the record in its own array
+(column) instead of storing whole records next to each other. A loop that reads one or two fields of a wide record
+then only pulls those columns through the cache, and the loop over a column is a plain loop over an array
+that the compiler can vectorize.
+
+For the remainder of this section, $name is the name of the custom type you definied.
+Use
+define_slice_soa(name,(type1,field1),(type2,field2),...)
+with 1 to 16 (type,field) pairs to create the struct $name, the struct $name_row which holds one record
+{type1 field1;type2 field2;...} and the following functions:
+
+//$name $name_make(size_t cap) creates a slice with the given capacity in every column, when done with the slice you MUST call
+//$name_destroy on it to prevent memory leaks.
+$name $name_make(size_t cap);
+
+//void $name_destroy($name* the_thing) frees every column.
+void $name_destroy($name* the_thing);
+
+//int $name_reserve($name* the_thing,size_t new_cap) / int $name_grow($name* the_thing,size_t needed) are the same as
+//for regular slices, every column is grown at the same time so they always share one capacity,
+//each column is reallocated in place when the allocator can and the capacity is only raised once all of them grew,
+//so on failure the length, capacity and elements are unchanged (some columns may just have extra room).
+int $name_reserve($name* the_thing,size_t new_cap);
+int $name_grow($name* the_thing,size_t needed);
+
+//int $name_append($name* the_thing,$name_row row) adds a record to the end of the slice, returns 0 on failure and 1 on success.
+int $name_append($name* the_thing,$name_row row);
+
+//$name_row $name_at($name* the_thing,size_t index) / void $name_set($name* the_thing,size_t index,$name_row row)
+//read and write a whole record with no bounds checks, $name_bounded_at and $name_bounded_set check the index first
+//and return 0 if it is out of bounds.
+$name_row $name_at($name* the_thing,size_t index);
+void $name_set($name* the_thing,size_t index,$name_row row);
+int $name_bounded_at($name* the_thing,size_t index,$name_row* result);
+int $name_bounded_set($name* the_thing,size_t index,$name_row row);
+
+//int $name_pop($name* the_thing,$name_row* result) removes the last record, returns 0 if the slice is empty.
+int $name_pop($name* the_thing,$name_row* result);
+
+//int $name_resize($name* the_thing,size_t new_size) sets the length (and maybe capacity) of the slice.
+int $name_resize($name* the_thing,size_t new_size);
+
+//int $name_ok($name the_thing), size_t $name_length($name the_thing), size_t $name_cap($name the_thing)
+//are the same as for regular slices.
+
+//type1* $name_field1($name* the_thing) returns the column of field1, the elements [0,length) are the field1 of each record,
+//the pointer is invalidated by anything that grows the slice. One such function is created for every field.
+type1* $name_field1($name* the_thing);
+
+A field may not be named like one of the functions above or like the length and capacity of the slice
+(SLICE_LENGTH_VARAIABLE_NAME and SLICE_CAPACITY_VARAIABLE_NAME).
+*/
+
+/*
+___slice_soa_for_each___(M,ctx,...) expands M(ctx,pair) for each (type,field) pair, not meant to be used outside this file.
+*/
+#define ___slice_soa_cat___(a,b) ___slice_soa_cat_inner___(a,b)
+#define ___slice_soa_cat_inner___(a,b) a ## b
+#define ___slice_soa_count___(...) ___slice_soa_count_n___(__VA_ARGS__,16,15,14,13,12,11,10,9,8,7,6,5,4,3,2,1,0)
+#define ___slice_soa_count_n___(_1,_2,_3,_4,_5,_6,_7,_8,_9,_10,_11,_12,_13,_14,_15,_16,N,...) N
+#define ___slice_soa_for_each___(M,ctx,...) ___slice_soa_cat___(___slice_soa_for_each_,___slice_soa_count___(__VA_ARGS__))(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_1(M,ctx,x) M(ctx,x)
+#define ___slice_soa_for_each_2(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_1(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_3(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_2(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_4(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_3(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_5(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_4(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_6(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_5(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_7(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_6(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_8(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_7(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_9(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_8(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_10(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_9(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_11(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_10(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_12(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_11(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_13(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_12(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_14(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_13(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_15(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_14(M,ctx,__VA_ARGS__)
+#define ___slice_soa_for_each_16(M,ctx,x,...) M(ctx,x) ___slice_soa_for_each_15(M,ctx,__VA_ARGS__)
+
+//the type and the field of a (type,field) pair
+#define ___slice_soa_type___(pair) ___slice_soa_first___ pair
+#define ___slice_soa_field___(pair) ___slice_soa_second___ pair
+#define ___slice_soa_first___(a,b) a
+#define ___slice_soa_second___(a,b) b
+//___slice_function_name___ with its arguments expanded first, so it can be given a field from a pair
+#define ___slice_soa_function_name___(x,y) ___slice_function_name___(x,y)
+
+/*
+the pieces of code repeated for every field, ctx is the slice name or the variable the piece works on.
+*/
+#define ___slice_soa_column_member___(ctx,pair) ___slice_soa_type___(pair)* ___slice_soa_field___(pair);
+#define ___slice_soa_row_member___(ctx,pair) ___slice_soa_type___(pair) ___slice_soa_field___(pair);
+#define ___slice_soa_row_size___(ctx,pair) + sizeof(___slice_soa_type___(pair))
+#define ___slice_soa_column_ok___(ctx,pair) && ctx.___slice_soa_field___(pair) != NULL
+#define ___slice_soa_column_make___(ctx,pair) \
+    ctx.___slice_soa_field___(pair) = slice_calloc(___slice_soa_type___(pair),slice_unsafe_value_cap(ctx));\
+    failed |= slice_alloc_failed(ctx.___slice_soa_field___(pair));
+#define ___slice_soa_column_free___(ctx,pair) slice_free(ctx->___slice_soa_field___(pair));ctx->___slice_soa_field___(pair) = NULL;
+#define ___slice_soa_column_reserve___(ctx,pair) {\
+    ___slice_soa_type___(pair)* grown = slice_realloc(___slice_soa_type___(pair),ctx->___slice_soa_field___(pair),new_cap);\
+    if(slice_alloc_failed(grown)){return 0;}\
+    ctx->___slice_soa_field___(pair) = grown;\
+}
+#define ___slice_soa_column_read___(ctx,pair) row.___slice_soa_field___(pair) = ctx->___slice_soa_field___(pair)[index];
+#define ___slice_soa_column_write___(ctx,pair) ctx->___slice_soa_field___(pair)[index] = row.___slice_soa_field___(pair);
+#define ___slice_soa_column_accessor_decl___(name,pair) \
+SLICE_C_BEGIN ___slice_soa_type___(pair)* ___slice_soa_function_name___(___slice_soa_field___(pair),name)(name* the_thing); SLICE_C_END;
+#define ___slice_soa_column_accessor___(name,pair) \
+SLICE_C_BEGIN ___slice_soa_type___(pair)* ___slice_soa_function_name___(___slice_soa_field___(pair),name)(name* the_thing){\
+    return the_thing == NULL ? NULL : the_thing->___slice_soa_field___(pair);\
+} SLICE_C_END;
+
+/*
+define_slice_soa_struct(name,...) creates the $name and $name_row structs.
+*/
+#define define_slice_soa_struct(name,...) \
+SLICE_C_BEGIN typedef struct name{\
+    ___slice_soa_for_each___(___slice_soa_column_member___,name,__VA_ARGS__)\
+    size_t SLICE_LENGTH_VARAIABLE_NAME;\
+    size_t SLICE_CAPACITY_VARAIABLE_NAME;\
+} name; SLICE_C_END;\
+SLICE_C_BEGIN typedef struct ___slice_function_name___(row,name){\
+    ___slice_soa_for_each___(___slice_soa_row_member___,name,__VA_ARGS__)\
+} ___slice_function_name___(row,name); SLICE_C_END
+
+/*
+define_slice_soa_declarations(name,...) creates the structs and the declarations of the functions of define_slice_soa.
+*/
+#define define_slice_soa_declarations(name,...) define_slice_soa_struct(name,__VA_ARGS__);\
+SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t cap); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,___slice_function_name___(row,name) row); SLICE_C_END;\
+SLICE_C_BEGIN ___slice_function_name___(row,name) ___slice_function_name___(at,name)(name* the_thing,size_t index); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(set,name)(name* the_thing,size_t index,___slice_function_name___(row,name) row); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,___slice_function_name___(row,name)* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(bounded_set,name)(name* the_thing,size_t index,___slice_function_name___(row,name) row); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(pop,name)(name* the_thing,___slice_function_name___(row,name)* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing); SLICE_C_END;\
+___slice_soa_for_each___(___slice_soa_column_accessor_decl___,name,__VA_ARGS__)\
+define_slice_length_decl(name);\
+define_slice_cap_decl(name)
+
+/*
+define_slice_soa_definitions(name,...) creates the definitions of the functions of define_slice_soa.
+*/
+#define define_slice_soa_definitions(name,...) \
+SLICE_C_BEGIN name ___slice_function_name___(make,name)(size_t cap){\
+    name output;\
+    int failed = 0;\
+    slice_unsafe_value_len(output) = 0;\
+    slice_unsafe_value_cap(output) = cap == 0 ? 10 : cap;\
+    ___slice_soa_for_each___(___slice_soa_column_make___,output,__VA_ARGS__)\
+    if(failed){\
+        ___slice_function_name___(destroy,name)(&output);\
+    }\
+    return output;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(destroy,name)(name* the_thing){\
+    if(the_thing == NULL){return;}\
+    ___slice_soa_for_each___(___slice_soa_column_free___,the_thing,__VA_ARGS__)\
+    slice_unsafe_raw_len(the_thing) = 0;\
+    slice_unsafe_raw_cap(the_thing) = 0;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(ok,name)(name the_thing){\
+    return slice_unsafe_value_len(the_thing) <= slice_unsafe_value_cap(the_thing) ___slice_soa_for_each___(___slice_soa_column_ok___,the_thing,__VA_ARGS__);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(reserve,name)(name* the_thing,size_t new_cap){\
+    if(the_thing == NULL||!___slice_function_name___(ok,name)(*the_thing)){return 0;}\
+    if(new_cap <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    if(new_cap > ((size_t)-1)/(0 ___slice_soa_for_each___(___slice_soa_row_size___,name,__VA_ARGS__))){return 0;}\
+    ___slice_soa_for_each___(___slice_soa_column_reserve___,the_thing,__VA_ARGS__)\
+    slice_unsafe_raw_cap(the_thing) = new_cap;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(grow,name)(name* the_thing,size_t needed){\
+    size_t new_cap;\
+    if(the_thing == NULL){return 0;}\
+    if(needed <= slice_unsafe_raw_cap(the_thing)){return 1;}\
+    new_cap = SLICE_GROWTH_POLICY(slice_unsafe_raw_cap(the_thing),needed,sizeof(___slice_function_name___(row,name)));\
+    if(new_cap < needed){new_cap = needed;}\
+    return ___slice_function_name___(reserve,name)(the_thing,new_cap);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(append,name)(name* the_thing,___slice_function_name___(row,name) row){\
+    size_t index;\
+    if(the_thing == NULL){return 0;}\
+    index = slice_unsafe_raw_len(the_thing);\
+    if(index >= slice_unsafe_raw_cap(the_thing) && slice_grow_failed(___slice_function_name___(grow,name)(the_thing,index + 1))){return 0;}\
+    ___slice_soa_for_each___(___slice_soa_column_write___,the_thing,__VA_ARGS__)\
+    slice_unsafe_raw_len(the_thing)++;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN ___slice_function_name___(row,name) ___slice_function_name___(at,name)(name* the_thing,size_t index){\
+    ___slice_function_name___(row,name) row;\
+    ___slice_soa_for_each___(___slice_soa_column_read___,the_thing,__VA_ARGS__)\
+    return row;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(set,name)(name* the_thing,size_t index,___slice_function_name___(row,name) row){\
+    ___slice_soa_for_each___(___slice_soa_column_write___,the_thing,__VA_ARGS__)\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(bounded_at,name)(name* the_thing,size_t index,___slice_function_name___(row,name)* result){\
+    if(the_thing == NULL||result == NULL||index >= slice_unsafe_raw_len(the_thing)){return 0;}\
+    *result = ___slice_function_name___(at,name)(the_thing,index);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(bounded_set,name)(name* the_thing,size_t index,___slice_function_name___(row,name) row){\
+    if(the_thing == NULL||index >= slice_unsafe_raw_len(the_thing)){return 0;}\
+    ___slice_function_name___(set,name)(the_thing,index,row);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(pop,name)(name* the_thing,___slice_function_name___(row,name)* result){\
+    if(the_thing == NULL||slice_unsafe_raw_len(the_thing) == 0){return 0;}\
+    slice_unsafe_raw_len(the_thing)--;\
+    if(result != NULL){*result = ___slice_function_name___(at,name)(the_thing,slice_unsafe_raw_len(the_thing));}\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(resize,name)(name* the_thing,size_t new_size){\
+    if(the_thing == NULL||!___slice_function_name___(ok,name)(*the_thing)){return 0;}\
+    if(new_size > slice_unsafe_raw_cap(the_thing) && slice_grow_failed(___slice_function_name___(grow,name)(the_thing,new_size))){return 0;}\
+    slice_unsafe_raw_len(the_thing) = new_size;\
+    return 1;\
+} SLICE_C_END;\
+___slice_soa_for_each___(___slice_soa_column_accessor___,name,__VA_ARGS__)\
+define_slice_length(name);\
+define_slice_cap(name)
+
+/*
+define_slice_soa(name,(type1,field1),(type2,field2),...) creates a structure of arrays slice named $name
+holding records of the given fields, as described at the top of this file.
+If you wish to seperate the functions from the declearations you may use
+define_slice_soa_declarations(name,...) and define_slice_soa_definitions(name,...).
+*/
+#define define_slice_soa(name,...) define_slice_soa_declarations(name,__VA_ARGS__);define_slice_soa_definitions(name,__VA_ARGS__)
+
+
+
+#endif
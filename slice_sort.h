@@ -0,0 +1,1084 @@
+/*
+Author: Blake Brown
+*/
+#ifndef CUSTOM_SLICES_SORT
+
+
+#define CUSTOM_SLICES_SORT 1
+#include "slice.h"
+
+/*
+This file adds ordering support for slices.
+
+For the remainder of this section, $name is the name of the custom type you definied, and $type
+is the type of an individual element in the container.
+LESS is a function-like macro or an inline function taking two $type values, LESS(a,b) must be nonzero
+when a goes strictly before b. Since LESS is pasted into the generated code, the compiler sees every comparison
+and can inline it, unlike the comparator pointer of qsort.
+For example:
+#define int_less(a,b) ((a) < (b))
+#define point_less(a,b) ((a).x < (b).x || ((a).x == (b).x && (a).y < (b).y))
+
+After defining a slice with define_slice(name,type), use
+define_slice_sort(name,type,LESS)
+to create the following functions:
+
+//void $name_sort($name* the_thing) sorts the slice (introsort: quicksort with median of 3 pivots,
+//insertion sort on small ranges and heapsort if the recursion gets too deep, O(n log n) and not stable).
+void $name_sort($name* the_thing);
+
+//void $name_sort_ptr(type* data,size_t len) sorts len elements starting at data.
+void $name_sort_ptr(type* data,size_t len);
+
+//int $name_is_sorted($name* the_thing) returns 1 if the slice is sorted, 0 otherwise.
+int $name_is_sorted($name* the_thing);
+
+//int $name_parallel_sort($name* the_thing,size_t nthreads) splits the slice into nthreads chunks, sorts them
+//on nthreads threads and merges them pairwise (also on several threads), using a scratch buffer as large as the slice.
+//the threads are started once per call and reused for the chunk sorts and every merge level.
+//returns 1 on success and 0 if the scratch buffer couldn't be allocated (the slice is left unchanged).
+int $name_parallel_sort($name* the_thing,size_t nthreads);
+
+$name_parallel_sort uses pthreads, define SLICE_NO_THREADS to build without them
+(the chunks are then sorted and merged on the calling thread).
+*/
+
+#if defined(_WIN32) && !defined(SLICE_NO_THREADS)
+#define SLICE_NO_THREADS 1
+#endif
+#ifndef SLICE_NO_THREADS
+#include <pthread.h>
+#endif
+
+#ifndef SLICE_SORT_INSERTION_THRESHOLD
+//ranges with at most this many elements are insertion sorted
+#define SLICE_SORT_INSERTION_THRESHOLD 16
+#endif
+
+#ifndef SLICE_PARALLEL_SORT_MIN_CHUNK
+//$name_parallel_sort doesn't give a thread less than this many elements
+#define SLICE_PARALLEL_SORT_MIN_CHUNK 8192
+#endif
+
+//$name_parallel_sort never uses more than this many threads
+#define SLICE_PARALLEL_SORT_MAX_THREADS 64
+
+//swaps two lvalues of type $type
+#define slice_swap(type,a,b) do{type ___slice_swap_tmp___ = (a);(a) = (b);(b) = ___slice_swap_tmp___;}while(0)
+
+/*
+slice_sort_pool is the set of worker threads of one $name_parallel_sort call, they are started once
+and run the chunk sorts and every merge level, the calling thread works too. Not meant to be used outside this file.
+*/
+SLICE_C_BEGIN
+typedef struct slice_sort_pool {
+#ifndef SLICE_NO_THREADS
+    pthread_mutex_t lock;
+    pthread_cond_t work; //signaled when a round of tasks is posted or the pool stops
+    pthread_cond_t done; //signaled when the last task of a round is finished
+    pthread_t threads[SLICE_PARALLEL_SORT_MAX_THREADS];
+    int synced; //1 once lock,work and done are initialized
+#endif
+    size_t nthreads;
+    void* (*run)(void*);
+    char* tasks;
+    size_t task_size;
+    size_t count;   //tasks of the current round
+    size_t next;    //first task of the round no thread took yet
+    size_t pending; //tasks of the round not finished yet
+    int stop;
+} slice_sort_pool;
+SLICE_C_END
+
+#ifndef SLICE_NO_THREADS
+//takes and runs the tasks of the current round until none is left, called with the pool locked and returns with it locked
+static inline void slice_sort_pool_drain(slice_sort_pool* pool){
+    while(pool->next < pool->count){
+        char* task = pool->tasks + pool->next++*pool->task_size;
+        pthread_mutex_unlock(&pool->lock);
+        pool->run(task);
+        pthread_mutex_lock(&pool->lock);
+        if(--pool->pending == 0){pthread_cond_signal(&pool->done);}
+    }
+}
+
+static inline void* slice_sort_pool_worker(void* arg){
+    slice_sort_pool* pool = (slice_sort_pool*)arg;
+    pthread_mutex_lock(&pool->lock);
+    for(;;){
+        while(!pool->stop && pool->next >= pool->count){pthread_cond_wait(&pool->work,&pool->lock);}
+        if(pool->stop){break;}
+        slice_sort_pool_drain(pool);
+    }
+    pthread_mutex_unlock(&pool->lock);
+    return NULL;
+}
+#endif
+
+//starts up to nthreads workers, if fewer (or none) could be started the calling thread does their share
+static inline void slice_sort_pool_start(slice_sort_pool* pool,size_t nthreads){
+    pool->nthreads = 0;
+    pool->count = pool->next = pool->pending = 0;
+    pool->stop = 0;
+#ifndef SLICE_NO_THREADS
+    pool->synced = 0;
+    if(nthreads == 0){return;}
+    if(pthread_mutex_init(&pool->lock,NULL) != 0){return;}
+    if(pthread_cond_init(&pool->work,NULL) != 0){pthread_mutex_destroy(&pool->lock);return;}
+    if(pthread_cond_init(&pool->done,NULL) != 0){pthread_cond_destroy(&pool->work);pthread_mutex_destroy(&pool->lock);return;}
+    pool->synced = 1;
+    if(nthreads > SLICE_PARALLEL_SORT_MAX_THREADS){nthreads = SLICE_PARALLEL_SORT_MAX_THREADS;}
+    while(pool->nthreads < nthreads && pthread_create(&pool->threads[pool->nthreads],NULL,slice_sort_pool_worker,pool) == 0){pool->nthreads++;}
+#else
+    (void)nthreads;
+#endif
+}
+
+//runs count tasks of task_size bytes each with run on the workers and the calling thread, returns when all are finished
+static inline void slice_sort_pool_run(slice_sort_pool* pool,void* (*run)(void*),void* tasks,size_t task_size,size_t count){
+    size_t i;
+    if(pool->nthreads == 0){
+        for(i = 0;i < count;i++){run((char*)tasks + i*task_size);}
+        return;
+    }
+#ifndef SLICE_NO_THREADS
+    pthread_mutex_lock(&pool->lock);
+    pool->run = run;
+    pool->tasks = (char*)tasks;
+    pool->task_size = task_size;
+    pool->next = 0;
+    pool->pending = pool->count = count;
+    pthread_cond_broadcast(&pool->work);
+    slice_sort_pool_drain(pool);
+    while(pool->pending != 0){pthread_cond_wait(&pool->done,&pool->lock);}
+    pool->count = pool->next = 0;
+    pthread_mutex_unlock(&pool->lock);
+#endif
+}
+
+//stops and joins the workers of a pool
+static inline void slice_sort_pool_stop(slice_sort_pool* pool){
+#ifndef SLICE_NO_THREADS
+    size_t i;
+    if(!pool->synced){return;}
+    pthread_mutex_lock(&pool->lock);
+    pool->stop = 1;
+    pthread_cond_broadcast(&pool->work);
+    pthread_mutex_unlock(&pool->lock);
+    for(i = 0;i < pool->nthreads;i++){pthread_join(pool->threads[i],NULL);}
+    pthread_cond_destroy(&pool->done);
+    pthread_cond_destroy(&pool->work);
+    pthread_mutex_destroy(&pool->lock);
+    pool->synced = 0;
+#endif
+    pool->nthreads = 0;
+}
+
+/*
+define_slice_sort_decl(name,type) creates the declarations of the functions of define_slice_sort.
+*/
+#define define_slice_sort_decl(name,type) \
+SLICE_C_BEGIN void ___slice_function_name___(sort_ptr,name)(type* data,size_t len); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(sort,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(is_sorted,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(parallel_sort,name)(name* the_thing,size_t nthreads); SLICE_C_END
+
+/*
+define_slice_sort_kernels(name,type,LESS) creates the static helpers of $name_sort, not meant to be used outside this file.
+*/
+#define define_slice_sort_kernels(name,type,LESS) \
+static void ___slice_function_name___(sort_insertion,name)(type* data,size_t lo,size_t hi){\
+    size_t i,j;\
+    for(i = lo + 1;i < hi;i++){\
+        type item = data[i];\
+        for(j = i;j > lo && LESS(item,data[j - 1]);j--){data[j] = data[j - 1];}\
+        data[j] = item;\
+    }\
+}\
+static void ___slice_function_name___(sort_sift_down,name)(type* data,size_t root,size_t len){\
+    type item = data[root];\
+    size_t child;\
+    while((child = 2*root + 1) < len){\
+        if(child + 1 < len && LESS(data[child],data[child + 1])){child++;}\
+        if(!LESS(item,data[child])){break;}\
+        data[root] = data[child];\
+        root = child;\
+    }\
+    data[root] = item;\
+}\
+static void ___slice_function_name___(sort_heapsort,name)(type* data,size_t len){\
+    size_t i;\
+    for(i = len/2;i-- > 0;){___slice_function_name___(sort_sift_down,name)(data,i,len);}\
+    for(i = len;i-- > 1;){\
+        slice_swap(type,data[0],data[i]);\
+        ___slice_function_name___(sort_sift_down,name)(data,0,i);\
+    }\
+}\
+static void ___slice_function_name___(sort_sort3,name)(type* data,size_t a,size_t b,size_t c){\
+    if(LESS(data[b],data[a])){slice_swap(type,data[a],data[b]);}\
+    if(LESS(data[c],data[b])){\
+        slice_swap(type,data[b],data[c]);\
+        if(LESS(data[b],data[a])){slice_swap(type,data[a],data[b]);}\
+    }\
+}\
+static void ___slice_function_name___(sort_intro,name)(type* data,size_t lo,size_t hi,size_t depth){\
+    while(hi - lo > SLICE_SORT_INSERTION_THRESHOLD){\
+        size_t mid = lo + (hi - lo)/2,i = lo,j = hi;\
+        type pivot;\
+        if(depth == 0){\
+            ___slice_function_name___(sort_heapsort,name)(data + lo,hi - lo);\
+            return;\
+        }\
+        depth--;\
+        if(hi - lo > 128){\
+            size_t step = (hi - lo)/8;\
+            ___slice_function_name___(sort_sort3,name)(data,lo,lo + step,lo + 2*step);\
+            ___slice_function_name___(sort_sort3,name)(data,mid - step,mid,mid + step);\
+            ___slice_function_name___(sort_sort3,name)(data,hi - 1 - 2*step,hi - 1 - step,hi - 1);\
+            ___slice_function_name___(sort_sort3,name)(data,lo + step,mid,hi - 1 - step);\
+        }else{\
+            ___slice_function_name___(sort_sort3,name)(data,lo,mid,hi - 1);\
+        }\
+        slice_swap(type,data[lo],data[mid]);\
+        pivot = data[lo];\
+        for(;;){\
+            do{i++;}while(i < hi && LESS(data[i],pivot));\
+            do{j--;}while(LESS(pivot,data[j]));\
+            if(i >= j){break;}\
+            slice_swap(type,data[i],data[j]);\
+        }\
+        slice_swap(type,data[lo],data[j]);\
+        if(j - lo < hi - j - 1){\
+            ___slice_function_name___(sort_intro,name)(data,lo,j,depth);\
+            lo = j + 1;\
+        }else{\
+            ___slice_function_name___(sort_intro,name)(data,j + 1,hi,depth);\
+            hi = j;\
+        }\
+    }\
+    ___slice_function_name___(sort_insertion,name)(data,lo,hi);\
+}\
+SLICE_C_BEGIN typedef struct ___slice_function_name___(sort_task,name){\
+    type* src;\
+    type* dst;\
+    size_t lo,mid,hi;\
+    int merge;\
+} ___slice_function_name___(sort_task,name); SLICE_C_END;\
+static void* ___slice_function_name___(sort_run_task,name)(void* arg){\
+    ___slice_function_name___(sort_task,name)* task = (___slice_function_name___(sort_task,name)*)arg;\
+    size_t i = task->lo,j = task->mid,out = task->lo;\
+    if(!task->merge){\
+        ___slice_function_name___(sort_ptr,name)(task->src + task->lo,task->hi - task->lo);\
+        return NULL;\
+    }\
+    while(i < task->mid && j < task->hi){\
+        if(LESS(task->src[j],task->src[i])){task->dst[out++] = task->src[j++];}\
+        else{task->dst[out++] = task->src[i++];}\
+    }\
+    while(i < task->mid){task->dst[out++] = task->src[i++];}\
+    while(j < task->hi){task->dst[out++] = task->src[j++];}\
+    return NULL;\
+}\
+static void ___slice_function_name___(sort_run_tasks,name)(slice_sort_pool* pool,___slice_function_name___(sort_task,name)* tasks,size_t count){\
+    slice_sort_pool_run(pool,___slice_function_name___(sort_run_task,name),tasks,sizeof(tasks[0]),count);\
+}
+
+/*
+define_slice_sort_definitions(name,type,LESS) creates the definitions of the functions of define_slice_sort.
+*/
+#define define_slice_sort_definitions(name,type,LESS) define_slice_sort_kernels(name,type,LESS)\
+SLICE_C_BEGIN void ___slice_function_name___(sort_ptr,name)(type* data,size_t len){\
+    size_t depth = 0,n;\
+    if(data == NULL||len < 2){return;}\
+    for(n = len;n > 1;n >>= 1){depth += 2;}\
+    ___slice_function_name___(sort_intro,name)(data,0,len,depth);\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(sort,name)(name* the_thing){\
+    if(the_thing == NULL){return;}\
+    ___slice_function_name___(sort_ptr,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing));\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(is_sorted,name)(name* the_thing){\
+    size_t i;\
+    if(the_thing == NULL){return 1;}\
+    for(i = 1;i < slice_unsafe_raw_len(the_thing);i++){\
+        if(LESS(slice_unsafe_raw_storage_ptr(the_thing)[i],slice_unsafe_raw_storage_ptr(the_thing)[i - 1])){return 0;}\
+    }\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(parallel_sort,name)(name* the_thing,size_t nthreads){\
+    ___slice_function_name___(sort_task,name) tasks[SLICE_PARALLEL_SORT_MAX_THREADS];\
+    size_t bounds[SLICE_PARALLEL_SORT_MAX_THREADS + 1];\
+    size_t len,runs,i;\
+    slice_sort_pool pool;\
+    type* data;\
+    type* scratch;\
+    if(the_thing == NULL){return 0;}\
+    len = slice_unsafe_raw_len(the_thing);\
+    data = slice_unsafe_raw_storage_ptr(the_thing);\
+    if(nthreads > SLICE_PARALLEL_SORT_MAX_THREADS){nthreads = SLICE_PARALLEL_SORT_MAX_THREADS;}\
+    if(nthreads > len/SLICE_PARALLEL_SORT_MIN_CHUNK){nthreads = len/SLICE_PARALLEL_SORT_MIN_CHUNK;}\
+    if(nthreads < 2){\
+        ___slice_function_name___(sort_ptr,name)(data,len);\
+        return 1;\
+    }\
+    scratch = slice_calloc(type,len);\
+    if(slice_alloc_failed(scratch)){return 0;}\
+    for(i = 0;i <= nthreads;i++){bounds[i] = len/nthreads*i + (i < len%nthreads ? i : len%nthreads);}\
+    for(i = 0;i < nthreads;i++){\
+        tasks[i].src = data;\
+        tasks[i].dst = scratch;\
+        tasks[i].lo = bounds[i];\
+        tasks[i].mid = tasks[i].hi = bounds[i + 1];\
+        tasks[i].merge = 0;\
+    }\
+    slice_sort_pool_start(&pool,nthreads - 1);\
+    ___slice_function_name___(sort_run_tasks,name)(&pool,tasks,nthreads);\
+    for(runs = nthreads;runs > 1;runs = (runs + 1)/2){\
+        for(i = 0;i < (runs + 1)/2;i++){\
+            tasks[i].src = data;\
+            tasks[i].dst = scratch;\
+            tasks[i].lo = bounds[2*i];\
+            tasks[i].mid = bounds[2*i + 1];\
+            tasks[i].hi = bounds[2*i + 2 <= runs ? 2*i + 2 : 2*i + 1];\
+            tasks[i].merge = 1;\
+            bounds[i] = tasks[i].lo;\
+        }\
+        bounds[(runs + 1)/2] = len;\
+        ___slice_function_name___(sort_run_tasks,name)(&pool,tasks,(runs + 1)/2);\
+        data = scratch;\
+        scratch = tasks[0].src;\
+    }\
+    slice_sort_pool_stop(&pool);\
+    if(data != slice_unsafe_raw_storage_ptr(the_thing)){\
+        slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing),data,len);\
+        scratch = data;\
+    }\
+    slice_free(scratch);\
+    return 1;\
+} SLICE_C_END
+
+/*
+define_slice_sort(name,type,LESS) creates the sort functions described at the top of this file for the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_sort(name,type,LESS) define_slice_sort_decl(name,type);define_slice_sort_definitions(name,type,LESS)
+
+
+/*
+Radix sort.
+For slices of fixed width keys (unsigned and signed integers of 1 to 8 bytes, float and double),
+after defining a slice with define_slice(name,type), use
+define_slice_radix(name,type)
+to create the following functions:
+
+//int $name_radix_sort($name* the_thing,$name* scratch) sorts the slice in ascending order with an LSD radix sort
+//(one byte per pass, passes where every key has the same byte are skipped).
+//scratch is a second slice used as the buffer the elements are moved into, its capacity is grown to the length of
+//the_thing and kept, so reusing it across calls avoids allocating, its length is left unchanged.
+//scratch may be NULL, a temporary buffer is then allocated and freed.
+//returns 1 on success and 0 if the buffer couldn't be allocated (the slice is left unchanged).
+int $name_radix_sort($name* the_thing,$name* scratch);
+
+//int $name_radix_sort_mt($name* the_thing,$name* scratch,size_t nthreads) is the same as $name_radix_sort but
+//builds the byte histograms on nthreads threads.
+int $name_radix_sort_mt($name* the_thing,$name* scratch,size_t nthreads);
+
+Floating point keys are ordered by flipping the sign bit of positive numbers and every bit of negative numbers,
+so -0.0 goes before 0.0 and NaNs go to the front (negative NaNs) or back (positive NaNs).
+Signed integers get their sign bit flipped. The kind of key is found from the type itself:
+((type)0.5) != 0 for floating point types and ((type)-1) < (type)1 for signed types.
+*/
+
+#include <stdint.h>
+
+/*
+define_slice_radix_decl(name,type) creates the declarations of the functions of define_slice_radix.
+*/
+#define define_slice_radix_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(radix_sort,name)(name* the_thing,name* scratch); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(radix_sort_mt,name)(name* the_thing,name* scratch,size_t nthreads); SLICE_C_END
+
+/*
+define_slice_radix_kernels(name,type) creates the static helpers of $name_radix_sort, not meant to be used outside this file.
+*/
+#define define_slice_radix_kernels(name,type) \
+static uint64_t ___slice_function_name___(radix_key,name)(type value){\
+    uint64_t key;\
+    if(((type)0.5) != 0){\
+        if(sizeof(type) == sizeof(float)){\
+            float f = (float)value;\
+            uint32_t bits;\
+            memcpy(&bits,&f,sizeof(bits));\
+            key = bits;\
+            return key ^ ((key >> 31) ? 0xFFFFFFFFu : 0x80000000u);\
+        }else{\
+            double d = (double)value;\
+            memcpy(&key,&d,sizeof(key));\
+            return key ^ ((key >> 63) ? ~(uint64_t)0 : (uint64_t)1 << 63);\
+        }\
+    }\
+    if(((type)-1) < (type)1){\
+        key = (uint64_t)(int64_t)value;\
+        if(sizeof(type) < sizeof(uint64_t)){key &= ((uint64_t)1 << (sizeof(type)*8 % 64)) - 1;}\
+        return key ^ ((uint64_t)1 << (sizeof(type)*8 - 1));\
+    }\
+    return (uint64_t)value;\
+}\
+SLICE_C_BEGIN typedef struct ___slice_function_name___(radix_task,name){\
+    const type* data;\
+    size_t lo,hi;\
+    size_t counts[sizeof(type)][256];\
+} ___slice_function_name___(radix_task,name); SLICE_C_END;\
+static void* ___slice_function_name___(radix_histogram,name)(void* arg){\
+    ___slice_function_name___(radix_task,name)* task = (___slice_function_name___(radix_task,name)*)arg;\
+    size_t i,digit;\
+    memset(task->counts,0,sizeof(task->counts));\
+    for(i = task->lo;i < task->hi;i++){\
+        uint64_t key = ___slice_function_name___(radix_key,name)(task->data[i]);\
+        for(digit = 0;digit < sizeof(type);digit++){task->counts[digit][(key >> (digit*8)) & 0xFF]++;}\
+    }\
+    return NULL;\
+}\
+static void ___slice_function_name___(radix_run_tasks,name)(___slice_function_name___(radix_task,name)* tasks,size_t count){\
+    slice_sort_pool pool;\
+    slice_sort_pool_start(&pool,count - 1);\
+    slice_sort_pool_run(&pool,___slice_function_name___(radix_histogram,name),tasks,sizeof(tasks[0]),count);\
+    slice_sort_pool_stop(&pool);\
+}
+
+/*
+define_slice_radix_definitions(name,type) creates the definitions of the functions of define_slice_radix.
+*/
+#define define_slice_radix_definitions(name,type) define_slice_radix_kernels(name,type)\
+SLICE_C_BEGIN int ___slice_function_name___(radix_sort_mt,name)(name* the_thing,name* scratch,size_t nthreads){\
+    ___slice_function_name___(radix_task,name)* tasks;\
+    size_t len,i,t,digit,sum;\
+    type* src;\
+    type* dst;\
+    type* buffer;\
+    if(the_thing == NULL||scratch == the_thing){return 0;}\
+    len = slice_unsafe_raw_len(the_thing);\
+    if(len < 2){return 1;}\
+    if(nthreads > SLICE_PARALLEL_SORT_MAX_THREADS){nthreads = SLICE_PARALLEL_SORT_MAX_THREADS;}\
+    if(nthreads > len/SLICE_PARALLEL_SORT_MIN_CHUNK){nthreads = len/SLICE_PARALLEL_SORT_MIN_CHUNK;}\
+    if(nthreads < 1){nthreads = 1;}\
+    if(scratch != NULL){\
+        if(slice_unsafe_raw_cap(scratch) < len && !___slice_function_name___(reserve,name)(scratch,len)){return 0;}\
+        buffer = slice_unsafe_raw_storage_ptr(scratch);\
+    }else{\
+        buffer = slice_calloc(type,len);\
+        if(slice_alloc_failed(buffer)){return 0;}\
+    }\
+    tasks = slice_calloc(___slice_function_name___(radix_task,name),nthreads);\
+    if(slice_alloc_failed(tasks)){\
+        if(scratch == NULL){slice_free(buffer);}\
+        return 0;\
+    }\
+    src = slice_unsafe_raw_storage_ptr(the_thing);\
+    dst = buffer;\
+    for(t = 0;t < nthreads;t++){\
+        tasks[t].data = src;\
+        tasks[t].lo = len/nthreads*t;\
+        tasks[t].hi = t + 1 == nthreads ? len : len/nthreads*(t + 1);\
+    }\
+    ___slice_function_name___(radix_run_tasks,name)(tasks,nthreads);\
+    for(t = 1;t < nthreads;t++){\
+        for(digit = 0;digit < sizeof(type);digit++){\
+            for(i = 0;i < 256;i++){tasks[0].counts[digit][i] += tasks[t].counts[digit][i];}\
+        }\
+    }\
+    for(digit = 0;digit < sizeof(type);digit++){\
+        size_t* counts = tasks[0].counts[digit];\
+        type* swap;\
+        uint64_t key = ___slice_function_name___(radix_key,name)(src[0]);\
+        if(counts[(key >> (digit*8)) & 0xFF] == len){continue;}\
+        for(i = 0,sum = 0;i < 256;i++){\
+            size_t count = counts[i];\
+            counts[i] = sum;\
+            sum += count;\
+        }\
+        for(i = 0;i < len;i++){\
+            key = ___slice_function_name___(radix_key,name)(src[i]);\
+            dst[counts[(key >> (digit*8)) & 0xFF]++] = src[i];\
+        }\
+        swap = src;\
+        src = dst;\
+        dst = swap;\
+    }\
+    if(src != slice_unsafe_raw_storage_ptr(the_thing)){slice_memcpy(type,slice_unsafe_raw_storage_ptr(the_thing),src,len);}\
+    slice_free(tasks);\
+    if(scratch == NULL){slice_free(buffer);}\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(radix_sort,name)(name* the_thing,name* scratch){\
+    return ___slice_function_name___(radix_sort_mt,name)(the_thing,scratch,1);\
+} SLICE_C_END
+
+/*
+define_slice_radix(name,type) creates the radix sort functions described above for the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_radix(name,type) define_slice_radix_decl(name,type);define_slice_radix_definitions(name,type)
+
+
+
+/*
+Sorted slices.
+For slices kept sorted by LESS, after defining a slice with define_slice(name,type), use
+define_slice_sorted(name,type,LESS)
+to create the following functions:
+
+//size_t $name_lower_bound($name* the_thing,type value) returns the index of the first element that is not before value
+//(the length of the slice if there is none).
+size_t $name_lower_bound($name* the_thing,type value);
+
+//size_t $name_upper_bound($name* the_thing,type value) returns the index of the first element that value goes before
+//(the length of the slice if there is none).
+size_t $name_upper_bound($name* the_thing,type value);
+
+//size_t $name_view_lower_bound($name_view view,type value) / size_t $name_view_upper_bound($name_view view,type value)
+//are the same searches on a view.
+size_t $name_view_lower_bound($name_view view,type value);
+size_t $name_view_upper_bound($name_view view,type value);
+
+//int $name_view_compare($name_view a,$name_view b) compares two views (sorted or not) element by element with LESS,
+//returns -1 if a goes before b, 1 if b goes before a and 0 if they hold equivalent elements.
+int $name_view_compare($name_view a,$name_view b);
+
+//int $name_sorted_insert($name* the_thing,type value) inserts value after the elements equal to it,
+//shifting the elements after it with one memmove, returns 0 on failure and 1 on success.
+int $name_sorted_insert($name* the_thing,type value);
+
+//the following functions replace the contents of out with the result of combining the sorted slices a and b,
+//out must not be a or b. Equal elements are matched one to one like the C++ <algorithm> set functions,
+//so a and b may hold duplicates. They return 0 on failure (out is then left empty) and 1 on success.
+int $name_merge($name* out,$name* a,$name* b);           every element of a and b
+int $name_set_union($name* out,$name* a,$name* b);       elements in a or b
+int $name_set_intersect($name* out,$name* a,$name* b);   elements in a and b
+int $name_set_difference($name* out,$name* a,$name* b);  elements in a but not in b
+
+The searches are branchless: every step is a conditional move instead of a branch the cpu could mispredict,
+and the two elements the next step may compare are prefetched so the memory loads overlap.
+*/
+
+/*
+define_slice_sorted_decl(name,type) creates the declarations of the functions of define_slice_sorted.
+*/
+#define define_slice_sorted_decl(name,type) \
+SLICE_C_BEGIN size_t ___slice_function_name___(lower_bound,name)(name* the_thing,type value); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(upper_bound,name)(name* the_thing,type value); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(view_lower_bound,name)(___slice_function_name___(view,name) view,type value); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(view_upper_bound,name)(___slice_function_name___(view,name) view,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_compare,name)(___slice_function_name___(view,name) a,___slice_function_name___(view,name) b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(sorted_insert,name)(name* the_thing,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(merge,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set_union,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set_intersect,name)(name* out,name* a,name* b); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set_difference,name)(name* out,name* a,name* b); SLICE_C_END
+
+/*
+___slice_sorted_prepare___(name,type,out,a,b,needed) checks the arguments of the merge and set functions and makes room
+for needed elements in out, not meant to be used outside this file.
+*/
+#define ___slice_sorted_prepare___(name,type,out,a,b,needed) \
+    if(out == NULL||a == NULL||b == NULL||out == a||out == b){return 0;}\
+    slice_unsafe_raw_len(out) = 0;\
+    if(slice_unsafe_raw_len(a) > slice_max_cap(type) - slice_unsafe_raw_len(b)){return 0;}\
+    if(slice_grow_failed(___slice_function_name___(grow,name)(out,needed))){return 0;}
+
+/*
+define_slice_sorted_definitions(name,type,LESS) creates the definitions of the functions of define_slice_sorted.
+*/
+#define define_slice_sorted_definitions(name,type,LESS) \
+static size_t ___slice_function_name___(sorted_lower,name)(const type* data,size_t n,type value){\
+    const type* base = data;\
+    size_t half;\
+    if(data == NULL||n == 0){return 0;}\
+    while(n > 1){\
+        half = n/2;\
+        slice_prefetch(base + half/2);\
+        slice_prefetch(base + half + half/2);\
+        base = LESS(base[half],value) ? base + half : base;\
+        n -= half;\
+    }\
+    return (size_t)(base - data) + (LESS(*base,value) ? 1 : 0);\
+}\
+static size_t ___slice_function_name___(sorted_upper,name)(const type* data,size_t n,type value){\
+    const type* base = data;\
+    size_t half;\
+    if(data == NULL||n == 0){return 0;}\
+    while(n > 1){\
+        half = n/2;\
+        slice_prefetch(base + half/2);\
+        slice_prefetch(base + half + half/2);\
+        base = LESS(value,base[half]) ? base : base + half;\
+        n -= half;\
+    }\
+    return (size_t)(base - data) + (LESS(value,*base) ? 0 : 1);\
+}\
+SLICE_C_BEGIN size_t ___slice_function_name___(lower_bound,name)(name* the_thing,type value){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(sorted_lower,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(upper_bound,name)(name* the_thing,type value){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(sorted_upper,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(view_lower_bound,name)(___slice_function_name___(view,name) view,type value){\
+    return ___slice_function_name___(sorted_lower,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(view_upper_bound,name)(___slice_function_name___(view,name) view,type value){\
+    return ___slice_function_name___(sorted_upper,name)(slice_unsafe_value_storage_ptr(view),slice_unsafe_value_len(view),value);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(view_compare,name)(___slice_function_name___(view,name) a,___slice_function_name___(view,name) b){\
+    size_t i,n = slice_unsafe_value_len(a) < slice_unsafe_value_len(b) ? slice_unsafe_value_len(a) : slice_unsafe_value_len(b);\
+    for(i = 0;i < n;i++){\
+        if(LESS(slice_unsafe_value_storage_ptr(a)[i],slice_unsafe_value_storage_ptr(b)[i])){return -1;}\
+        if(LESS(slice_unsafe_value_storage_ptr(b)[i],slice_unsafe_value_storage_ptr(a)[i])){return 1;}\
+    }\
+    return slice_unsafe_value_len(a) < slice_unsafe_value_len(b) ? -1 : slice_unsafe_value_len(a) > slice_unsafe_value_len(b) ? 1 : 0;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(sorted_insert,name)(name* the_thing,type value){\
+    if(the_thing == NULL){return 0;}\
+    return ___slice_function_name___(insert_n,name)(the_thing,___slice_function_name___(upper_bound,name)(the_thing,value),&value,1);\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(merge,name)(name* out,name* a,name* b){\
+    size_t i = 0,j = 0,k = 0,la,lb;\
+    const type* pa;\
+    const type* pb;\
+    type* po;\
+    ___slice_sorted_prepare___(name,type,out,a,b,slice_unsafe_raw_len(a) + slice_unsafe_raw_len(b))\
+    la = slice_unsafe_raw_len(a);lb = slice_unsafe_raw_len(b);\
+    pa = slice_unsafe_raw_storage_ptr(a);pb = slice_unsafe_raw_storage_ptr(b);po = slice_unsafe_raw_storage_ptr(out);\
+    while(i < la && j < lb){\
+        int take_b = LESS(pb[j],pa[i]) ? 1 : 0;\
+        po[k++] = take_b ? pb[j] : pa[i];\
+        j += take_b;\
+        i += !take_b;\
+    }\
+    while(i < la){po[k++] = pa[i++];}\
+    while(j < lb){po[k++] = pb[j++];}\
+    slice_unsafe_raw_len(out) = k;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set_union,name)(name* out,name* a,name* b){\
+    size_t i = 0,j = 0,k = 0,la,lb;\
+    const type* pa;\
+    const type* pb;\
+    type* po;\
+    ___slice_sorted_prepare___(name,type,out,a,b,slice_unsafe_raw_len(a) + slice_unsafe_raw_len(b))\
+    la = slice_unsafe_raw_len(a);lb = slice_unsafe_raw_len(b);\
+    pa = slice_unsafe_raw_storage_ptr(a);pb = slice_unsafe_raw_storage_ptr(b);po = slice_unsafe_raw_storage_ptr(out);\
+    while(i < la && j < lb){\
+        int a_first = LESS(pa[i],pb[j]) ? 1 : 0,b_first = LESS(pb[j],pa[i]) ? 1 : 0;\
+        po[k++] = b_first ? pb[j] : pa[i];\
+        i += !b_first;\
+        j += !a_first;\
+    }\
+    while(i < la){po[k++] = pa[i++];}\
+    while(j < lb){po[k++] = pb[j++];}\
+    slice_unsafe_raw_len(out) = k;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set_intersect,name)(name* out,name* a,name* b){\
+    size_t i = 0,j = 0,k = 0,la,lb;\
+    const type* pa;\
+    const type* pb;\
+    type* po;\
+    ___slice_sorted_prepare___(name,type,out,a,b,slice_unsafe_raw_len(a) < slice_unsafe_raw_len(b) ? slice_unsafe_raw_len(a) : slice_unsafe_raw_len(b))\
+    la = slice_unsafe_raw_len(a);lb = slice_unsafe_raw_len(b);\
+    pa = slice_unsafe_raw_storage_ptr(a);pb = slice_unsafe_raw_storage_ptr(b);po = slice_unsafe_raw_storage_ptr(out);\
+    while(i < la && j < lb){\
+        int a_first = LESS(pa[i],pb[j]) ? 1 : 0,b_first = LESS(pb[j],pa[i]) ? 1 : 0;\
+        po[k] = pa[i];\
+        k += !a_first && !b_first;\
+        i += !b_first;\
+        j += !a_first;\
+    }\
+    slice_unsafe_raw_len(out) = k;\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(set_difference,name)(name* out,name* a,name* b){\
+    size_t i = 0,j = 0,k = 0,la,lb;\
+    const type* pa;\
+    const type* pb;\
+    type* po;\
+    ___slice_sorted_prepare___(name,type,out,a,b,slice_unsafe_raw_len(a))\
+    la = slice_unsafe_raw_len(a);lb = slice_unsafe_raw_len(b);\
+    pa = slice_unsafe_raw_storage_ptr(a);pb = slice_unsafe_raw_storage_ptr(b);po = slice_unsafe_raw_storage_ptr(out);\
+    while(i < la && j < lb){\
+        int a_first = LESS(pa[i],pb[j]) ? 1 : 0,b_first = LESS(pb[j],pa[i]) ? 1 : 0;\
+        po[k] = pa[i];\
+        k += a_first;\
+        i += !b_first;\
+        j += !a_first;\
+    }\
+    while(i < la){po[k++] = pa[i++];}\
+    slice_unsafe_raw_len(out) = k;\
+    return 1;\
+} SLICE_C_END
+
+/*
+define_slice_sorted(name,type,LESS) creates the sorted slice functions described above for the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_sorted(name,type,LESS) define_slice_sorted_decl(name,type);define_slice_sorted_definitions(name,type,LESS)
+
+
+
+/*
+Eytzinger layout.
+A sorted array is binary searched from the middle out, so nearly every probe of a large slice misses the cache.
+The Eytzinger layout stores the elements in the order of a breadth first walk of the implicit search tree
+(the children of position k are 2k and 2k+1), the first levels share a few cache lines and the descendants
+of a node a few levels down are next to each other, so they can be prefetched a whole cache line ahead.
+After defining a slice with define_slice(name,type), use
+define_slice_eytzinger(name,type,LESS)
+to create the struct $name_eytzinger and the following functions:
+
+//int $name_build_eytzinger($name* the_thing,$name_eytzinger* out) copies the slice (which does not need to be sorted)
+//into the Eytzinger layout, remembering the index each element had in the slice.
+//returns 0 on failure and 1 on success, a successfully built out must be destroyed with $name_eytzinger_destroy.
+int $name_build_eytzinger($name* the_thing,$name_eytzinger* out);
+
+//size_t $name_eytzinger_lower_bound($name_eytzinger* e,type value) returns the original index of the smallest element
+//that is not before value (the first one in the slice if there are several equal ones),
+//or the length of the original slice if every element goes before value.
+size_t $name_eytzinger_lower_bound($name_eytzinger* e,type value);
+
+//int $name_eytzinger_search($name_eytzinger* e,type value,size_t* index) returns 1 and fills index (if not NULL)
+//with the original index of an element equal to value if there is one, 0 otherwise.
+int $name_eytzinger_search($name_eytzinger* e,type value,size_t* index);
+
+//void $name_eytzinger_destroy($name_eytzinger* e) frees the layout.
+void $name_eytzinger_destroy($name_eytzinger* e);
+
+The layout is built once in O(n log n) and does not follow later changes to the slice.
+*/
+
+//removes the trailing 1 bits and the 0 bit above them from an Eytzinger position, giving the last node the search went left from
+static inline size_t slice_eytzinger_unwind(size_t k){
+#if defined(__GNUC__) || defined(__clang__)
+    return k >> (__builtin_ctzll(~(unsigned long long)k) + 1);
+#else
+    while(k & 1){k >>= 1;}
+    return k >> 1;
+#endif
+}
+
+/*
+define_slice_eytzinger_struct(name,type) creates the $name_eytzinger struct, keys[1..len] holds the elements in
+Eytzinger order and index[k] the original index of keys[k] (index[0] is len, for searches that found nothing).
+keys starts on a cache line boundary so the children k*block..k*block + block - 1 share one line,
+keys_storage is the allocation it points into.
+*/
+#define define_slice_eytzinger_struct(name,type) SLICE_C_BEGIN typedef struct ___slice_function_name___(eytzinger,name){\
+    type* keys;\
+    char* keys_storage;\
+    size_t* index;\
+    size_t len;\
+} ___slice_function_name___(eytzinger,name); SLICE_C_END
+
+/*
+define_slice_eytzinger_decl(name,type) creates the declarations of the functions of define_slice_eytzinger.
+*/
+#define define_slice_eytzinger_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(build_eytzinger,name)(name* the_thing,___slice_function_name___(eytzinger,name)* out); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(eytzinger_lower_bound,name)(___slice_function_name___(eytzinger,name)* e,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(eytzinger_search,name)(___slice_function_name___(eytzinger,name)* e,type value,size_t* index); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(eytzinger_destroy,name)(___slice_function_name___(eytzinger,name)* e); SLICE_C_END
+
+/*
+define_slice_eytzinger_kernels(name,type,LESS) creates the static helpers of the Eytzinger functions, not meant to be used outside this file.
+The original indices are sorted by the element they point to (equal elements by index) with a heapsort,
+then an in order walk of the implicit tree hands out the sorted elements.
+The search prefetches the cache line holding the descendants of k a few levels down (position k*block).
+*/
+#define define_slice_eytzinger_kernels(name,type,LESS) \
+static int ___slice_function_name___(eytzinger_before,name)(const type* data,size_t a,size_t b){\
+    if(LESS(data[a],data[b])){return 1;}\
+    if(LESS(data[b],data[a])){return 0;}\
+    return a < b;\
+}\
+static void ___slice_function_name___(eytzinger_sift_down,name)(const type* data,size_t* order,size_t root,size_t len){\
+    size_t item = order[root],child;\
+    while((child = 2*root + 1) < len){\
+        if(child + 1 < len && ___slice_function_name___(eytzinger_before,name)(data,order[child],order[child + 1])){child++;}\
+        if(!___slice_function_name___(eytzinger_before,name)(data,item,order[child])){break;}\
+        order[root] = order[child];\
+        root = child;\
+    }\
+    order[root] = item;\
+}\
+static size_t ___slice_function_name___(eytzinger_fill,name)(___slice_function_name___(eytzinger,name)* e,const type* data,const size_t* order,size_t next,size_t k){\
+    if(k > e->len){return next;}\
+    next = ___slice_function_name___(eytzinger_fill,name)(e,data,order,next,2*k);\
+    e->keys[k] = data[order[next]];\
+    e->index[k] = order[next];\
+    return ___slice_function_name___(eytzinger_fill,name)(e,data,order,next + 1,2*k + 1);\
+}\
+static size_t ___slice_function_name___(eytzinger_descend,name)(___slice_function_name___(eytzinger,name)* e,type value){\
+    const size_t block = SLICE_CACHE_LINE_SIZE/sizeof(type) > 1 ? SLICE_CACHE_LINE_SIZE/sizeof(type) : 1;\
+    size_t k = 1;\
+    while(k <= e->len){\
+        slice_prefetch(e->keys + (k*block <= e->len ? k*block : 0));\
+        k = 2*k + (LESS(e->keys[k],value) ? 1 : 0);\
+    }\
+    return slice_eytzinger_unwind(k);\
+}
+
+/*
+define_slice_eytzinger_definitions(name,type,LESS) creates the definitions of the functions of define_slice_eytzinger.
+*/
+#define define_slice_eytzinger_definitions(name,type,LESS) define_slice_eytzinger_kernels(name,type,LESS)\
+SLICE_C_BEGIN int ___slice_function_name___(build_eytzinger,name)(name* the_thing,___slice_function_name___(eytzinger,name)* out){\
+    const type* data;\
+    size_t* order;\
+    size_t len,i;\
+    if(the_thing == NULL||out == NULL){return 0;}\
+    data = slice_unsafe_raw_storage_ptr(the_thing);\
+    len = slice_unsafe_raw_len(the_thing);\
+    if(len >= slice_max_cap(type)||len >= slice_max_cap(size_t)){return 0;}\
+    out->len = len;\
+    out->keys_storage = slice_calloc(char,(len + 1)*sizeof(type) + SLICE_CACHE_LINE_SIZE);\
+    out->index = slice_calloc(size_t,len + 1);\
+    order = slice_calloc(size_t,len + 1);\
+    if(slice_alloc_failed(out->keys_storage)||slice_alloc_failed(out->index)||slice_alloc_failed(order)){\
+        slice_free(out->keys_storage);\
+        slice_free(out->index);\
+        slice_free(order);\
+        out->keys = NULL;\
+        out->keys_storage = NULL;\
+        out->index = NULL;\
+        out->len = 0;\
+        return 0;\
+    }\
+    out->keys = (type*)(out->keys_storage + (SLICE_CACHE_LINE_SIZE - (uintptr_t)out->keys_storage % SLICE_CACHE_LINE_SIZE));\
+    for(i = 0;i < len;i++){order[i] = i;}\
+    for(i = len/2;i-- > 0;){___slice_function_name___(eytzinger_sift_down,name)(data,order,i,len);}\
+    for(i = len;i-- > 1;){\
+        size_t top = order[0];\
+        order[0] = order[i];\
+        order[i] = top;\
+        ___slice_function_name___(eytzinger_sift_down,name)(data,order,0,i);\
+    }\
+    ___slice_function_name___(eytzinger_fill,name)(out,data,order,0,1);\
+    out->index[0] = len;\
+    slice_free(order);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(eytzinger_lower_bound,name)(___slice_function_name___(eytzinger,name)* e,type value){\
+    if(e == NULL||e->keys == NULL){return 0;}\
+    return e->index[___slice_function_name___(eytzinger_descend,name)(e,value)];\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(eytzinger_search,name)(___slice_function_name___(eytzinger,name)* e,type value,size_t* index){\
+    size_t k;\
+    if(e == NULL||e->keys == NULL){return 0;}\
+    k = ___slice_function_name___(eytzinger_descend,name)(e,value);\
+    if(k == 0||LESS(value,e->keys[k])){return 0;}\
+    if(index != NULL){*index = e->index[k];}\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(eytzinger_destroy,name)(___slice_function_name___(eytzinger,name)* e){\
+    if(e == NULL){return;}\
+    slice_free(e->keys_storage);\
+    slice_free(e->index);\
+    e->keys = NULL;\
+    e->keys_storage = NULL;\
+    e->index = NULL;\
+    e->len = 0;\
+} SLICE_C_END
+
+/*
+define_slice_eytzinger(name,type,LESS) creates the $name_eytzinger struct and the functions described above
+for the slice $name of $type, the slice must have been defined before.
+*/
+#define define_slice_eytzinger(name,type,LESS) define_slice_eytzinger_struct(name,type);define_slice_eytzinger_decl(name,type);define_slice_eytzinger_definitions(name,type,LESS)
+
+/*
+Heaps (priority queues) kept in a slice.
+
+After defining a slice with define_slice(name,type), use
+define_slice_heap(name,type,LESS)
+to create the following functions. The top of the heap is an element that no other element goes after
+(the largest one for LESS(a,b) = a < b, use a > b for a min-heap of timers).
+Elements are only added and removed through these functions once the slice is a heap.
+
+//int $name_push($name* the_thing,type value) appends value and moves it up to its place, O(log n).
+//returns 0 on failure (the slice couldn't grow) and 1 on success.
+int $name_push($name* the_thing,type value);
+
+//int $name_pop_top($name* the_thing,type* result) removes the top and puts it into result (if not null), O(log n).
+//returns 0 if the heap is empty and 1 on success.
+int $name_pop_top($name* the_thing,type* result);
+
+//int $name_peek($name* the_thing,type* result) puts the top into result, returns 0 if the heap is empty and 1 on success.
+int $name_peek($name* the_thing,type* result);
+
+//void $name_heapify($name* the_thing) turns any slice into a heap in O(n).
+void $name_heapify($name* the_thing);
+
+//int $name_push_pop($name* the_thing,type value,type* result) pushes value then pops the top into result with a single
+//sift down (value itself is the result if it would be the top), the slice never grows. Returns 0 on error and 1 on success.
+int $name_push_pop($name* the_thing,type value,type* result);
+
+//size_t $name_top_k($name* the_thing,size_t k) moves the k elements closest to the top (the k largest for a < b)
+//to the start of the slice, ordered from the top, in O(n log k) without allocating, and returns how many were moved
+//(k or the length of the slice if it is shorter). The slice does not have to be a heap and is not one afterwards.
+size_t $name_top_k($name* the_thing,size_t k);
+
+define_slice_heap4(name,type,LESS) creates the same functions for a 4-ary heap: the 4 children of an element
+are next to each other, so a sift down visits half as many levels and usually reads a single cache line per level,
+which is faster than a binary heap for large queues (pushes compare less too, pops compare more).
+define_slice_heap_arity(name,type,LESS,D) takes the number of children D.
+*/
+
+/*
+define_slice_heap_sift_down(fn,type,BEFORE,D) creates the static function fn(type* data,size_t i,size_t len) that moves
+data[i] down a D-ary heap where no element goes after its parent according to BEFORE, not meant to be used outside this file.
+The grandchildren of the element are prefetched while its children are compared.
+*/
+#define define_slice_heap_sift_down(fn,type,BEFORE,D) \
+static void fn(type* data,size_t i,size_t len){\
+    type item = data[i];\
+    size_t child,best,end,c;\
+    while((child = (D)*i + 1) < len){\
+        if((D)*child + 1 < len){slice_prefetch(data + (D)*child + 1);}\
+        end = len - child > (D) ? child + (D) : len;\
+        best = child;\
+        for(c = child + 1;c < end;c++){\
+            if(BEFORE(data[best],data[c])){best = c;}\
+        }\
+        if(!BEFORE(item,data[best])){break;}\
+        data[i] = data[best];\
+        i = best;\
+    }\
+    data[i] = item;\
+}
+
+/*
+define_slice_heap_decl(name,type) creates the declarations of the functions of define_slice_heap.
+*/
+#define define_slice_heap_decl(name,type) \
+SLICE_C_BEGIN int ___slice_function_name___(push,name)(name* the_thing,type value); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(pop_top,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(peek,name)(name* the_thing,type* result); SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(heapify,name)(name* the_thing); SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(push_pop,name)(name* the_thing,type value,type* result); SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(top_k,name)(name* the_thing,size_t k); SLICE_C_END
+
+/*
+define_slice_heap_arity_definitions(name,type,LESS,D) creates the definitions of the functions of define_slice_heap
+for a heap where every element has D children.
+*/
+#define define_slice_heap_arity_definitions(name,type,LESS,D) \
+static inline int ___slice_function_name___(heap_after,name)(type a,type b){\
+    return LESS(b,a);\
+}\
+define_slice_heap_sift_down(___slice_function_name___(heap_sift_down,name),type,LESS,D)\
+define_slice_heap_sift_down(___slice_function_name___(heap_min_sift_down,name),type,___slice_function_name___(heap_after,name),D)\
+static void ___slice_function_name___(heap_sift_up,name)(type* data,size_t i){\
+    type item = data[i];\
+    size_t parent;\
+    while(i > 0){\
+        parent = (i - 1)/(D);\
+        if(!LESS(data[parent],item)){break;}\
+        data[i] = data[parent];\
+        i = parent;\
+    }\
+    data[i] = item;\
+}\
+SLICE_C_BEGIN int ___slice_function_name___(push,name)(name* the_thing,type value){\
+    if(the_thing == NULL||!___slice_function_name___(append,name)(the_thing,value)){return 0;}\
+    ___slice_function_name___(heap_sift_up,name)(slice_unsafe_raw_storage_ptr(the_thing),slice_unsafe_raw_len(the_thing) - 1);\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(pop_top,name)(name* the_thing,type* result){\
+    type* data;\
+    size_t len;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_len(the_thing) == 0){return 0;}\
+    data = slice_unsafe_raw_storage_ptr(the_thing);\
+    len = --slice_unsafe_raw_len(the_thing);\
+    if(result != NULL){*result = data[0];}\
+    if(len > 0){\
+        data[0] = data[len];\
+        ___slice_function_name___(heap_sift_down,name)(data,0,len);\
+    }\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(peek,name)(name* the_thing,type* result){\
+    if(the_thing == NULL||result == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_len(the_thing) == 0){return 0;}\
+    *result = slice_unsafe_raw_storage_ptr(the_thing)[0];\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN void ___slice_function_name___(heapify,name)(name* the_thing){\
+    size_t i,len;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||slice_unsafe_raw_len(the_thing) < 2){return;}\
+    len = slice_unsafe_raw_len(the_thing);\
+    for(i = (len - 2)/(D) + 1;i-- > 0;){\
+        ___slice_function_name___(heap_sift_down,name)(slice_unsafe_raw_storage_ptr(the_thing),i,len);\
+    }\
+} SLICE_C_END;\
+SLICE_C_BEGIN int ___slice_function_name___(push_pop,name)(name* the_thing,type value,type* result){\
+    type* data;\
+    if(the_thing == NULL||result == NULL){return 0;}\
+    data = slice_unsafe_raw_storage_ptr(the_thing);\
+    if(data == NULL||slice_unsafe_raw_len(the_thing) == 0||!LESS(value,data[0])){\
+        *result = value;\
+        return 1;\
+    }\
+    *result = data[0];\
+    data[0] = value;\
+    ___slice_function_name___(heap_sift_down,name)(data,0,slice_unsafe_raw_len(the_thing));\
+    return 1;\
+} SLICE_C_END;\
+SLICE_C_BEGIN size_t ___slice_function_name___(top_k,name)(name* the_thing,size_t k){\
+    type* data;\
+    type tmp;\
+    size_t len,i;\
+    if(the_thing == NULL||slice_unsafe_raw_storage_ptr(the_thing) == NULL||k == 0){return 0;}\
+    data = slice_unsafe_raw_storage_ptr(the_thing);\
+    len = slice_unsafe_raw_len(the_thing);\
+    if(k > len){k = len;}\
+    for(i = (k - 1)/(D) + 1;i-- > 0;){\
+        ___slice_function_name___(heap_min_sift_down,name)(data,i,k);\
+    }\
+    for(i = k;i < len;i++){\
+        if(LESS(data[0],data[i])){\
+            tmp = data[0];\
+            data[0] = data[i];\
+            data[i] = tmp;\
+            ___slice_function_name___(heap_min_sift_down,name)(data,0,k);\
+        }\
+    }\
+    for(i = k;i-- > 1;){\
+        tmp = data[0];\
+        data[0] = data[i];\
+        data[i] = tmp;\
+        ___slice_function_name___(heap_min_sift_down,name)(data,0,i);\
+    }\
+    return k;\
+} SLICE_C_END
+
+/*
+define_slice_heap_arity(name,type,LESS,D) creates the heap functions described above for a D-ary heap in the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_heap_arity(name,type,LESS,D) define_slice_heap_decl(name,type);define_slice_heap_arity_definitions(name,type,LESS,D)
+
+/*
+define_slice_heap(name,type,LESS) creates the heap functions described above for a binary heap in the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_heap(name,type,LESS) define_slice_heap_arity(name,type,LESS,2)
+
+/*
+define_slice_heap4(name,type,LESS) creates the heap functions described above for a 4-ary heap in the slice $name of $type,
+the slice must have been defined before.
+*/
+#define define_slice_heap4(name,type,LESS) define_slice_heap_arity(name,type,LESS,4)
+
+
+
+
+#endif
@@ -0,0 +1,223 @@
+/*
+Author: Blake Brown
+*/
+/*
+A standalone multi-threaded stress test of slice_concurrent.h, meant to be run under ThreadSanitizer.
+It needs a C11 compiler and pthreads, build and run it from the root of the repository with
+```
+    cc -std=c11 -O1 -g -fsanitize=thread -I. tests/slice_concurrent_stress.c -o slice_concurrent_stress -lpthread
+    ./slice_concurrent_stress
+```
+(-fsanitize=address,undefined works too). It prints ok and returns 0 when every check passed,
+otherwise it prints the failed check and returns 1.
+spsc: a producer pushes 0,1,2,... in batches of random sizes and the consumer checks it pops the same sequence.
+concurrent: writers append (writer,seq) records with $name_append and $name_append_n while readers validate every
+index below the length, then every record of every writer must be present exactly once.
+cow: threads clone one shared slice, write through their clones and check the shared slice never changes.
+*/
+#include "slice_concurrent.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#define STRESS_SPSC_ITEMS 1000000
+#define STRESS_WRITERS 4
+#define STRESS_READERS 4
+#define STRESS_PER_WRITER 50000
+#define STRESS_COW_THREADS 8
+#define STRESS_COW_ROUNDS 2000
+
+//set by any thread whose check failed
+static slice_atomic(int) failed;
+#define check(cond) do{if(!(cond)){fprintf(stderr,"%s:%d: check failed: %s\n",__FILE__,__LINE__,#cond);slice_atomic_store(&failed,1,relaxed);}}while(0)
+
+//a tiny xorshift generator, each thread has its own state
+static unsigned stress_rand(unsigned* state){
+    *state ^= *state << 13;
+    *state ^= *state >> 17;
+    *state ^= *state << 5;
+    return *state;
+}
+
+/*
+spsc
+*/
+define_slice_spsc(ring,size_t)
+
+static void* spsc_producer(void* arg){
+    ring* r = (ring*)arg;
+    size_t batch[64],next = 0,n,i,pushed;
+    unsigned seed = 12345;
+    while(next < STRESS_SPSC_ITEMS){
+        n = 1 + stress_rand(&seed)%64;
+        if(n > STRESS_SPSC_ITEMS - next){n = STRESS_SPSC_ITEMS - next;}
+        for(i = 0;i < n;i++){batch[i] = next + i;}
+        pushed = n == 1 ? (size_t)ring_try_push(r,batch[0]) : ring_try_push_n(r,batch,n);
+        next += pushed;
+        if(pushed == 0){sched_yield();} //the ring is full, let the consumer run on a machine with few cores
+    }
+    return NULL;
+}
+
+static void* spsc_consumer(void* arg){
+    ring* r = (ring*)arg;
+    size_t batch[64],expected = 0,n,i;
+    unsigned seed = 54321;
+    while(expected < STRESS_SPSC_ITEMS){
+        n = 1 + stress_rand(&seed)%64;
+        n = n == 1 ? (size_t)ring_try_pop(r,&batch[0]) : ring_try_pop_n(r,batch,n);
+        if(n == 0){sched_yield();}
+        for(i = 0;i < n;i++){
+            if(batch[i] != expected){
+                fprintf(stderr,"spsc: popped %zu, expected %zu\n",batch[i],expected);
+                slice_atomic_store(&failed,1,relaxed);
+                return NULL;
+            }
+            expected++;
+        }
+    }
+    return NULL;
+}
+
+static void stress_spsc(void){
+    ring r;
+    pthread_t producer,consumer;
+    check(ring_init(&r,100));
+    check(pthread_create(&producer,NULL,spsc_producer,&r) == 0);
+    check(pthread_create(&consumer,NULL,spsc_consumer,&r) == 0);
+    pthread_join(producer,NULL);
+    pthread_join(consumer,NULL);
+    check(ring_length(&r) == 0);
+    ring_destroy(&r);
+}
+
+/*
+concurrent
+*/
+typedef struct record{
+    unsigned writer;
+    unsigned seq;
+    unsigned check; //~(writer*STRESS_PER_WRITER + seq), a torn record fails it
+} record;
+define_slice_concurrent(records,record)
+
+static records shared_records;
+static slice_atomic(int) writers_done;
+
+static record make_record(unsigned writer,unsigned seq){
+    record out;
+    out.writer = writer;
+    out.seq = seq;
+    out.check = ~(writer*STRESS_PER_WRITER + seq);
+    return out;
+}
+
+static void* concurrent_writer(void* arg){
+    unsigned writer = (unsigned)(size_t)arg,seq = 0,n,i;
+    unsigned seed = 777 + writer;
+    record batch[16];
+    while(seq < STRESS_PER_WRITER){
+        n = 1 + stress_rand(&seed)%16;
+        if(n > STRESS_PER_WRITER - seq){n = STRESS_PER_WRITER - seq;}
+        for(i = 0;i < n;i++){batch[i] = make_record(writer,seq + i);}
+        if(n == 1){check(records_append(&shared_records,batch[0]));}
+        else{check(records_append_n(&shared_records,batch,n));}
+        seq += n;
+    }
+    slice_atomic_fetch_add(&writers_done,1,release);
+    return NULL;
+}
+
+static void* concurrent_reader(void* arg){
+    size_t i,len,first_unread = 0; //every index below first_unread was read and validated
+    record value;
+    (void)arg;
+    for(;;){
+        int done = slice_atomic_load(&writers_done,acquire) == STRESS_WRITERS;
+        int gap = 0;
+        len = records_length(&shared_records);
+        for(i = first_unread;i < len;i++){
+            //a reserved slot may not be written yet, but a readable one must hold a whole record
+            if(!records_bounded_at(&shared_records,i,&value)){gap = 1;continue;}
+            if(!gap){first_unread = i + 1;}
+            if(value.writer >= STRESS_WRITERS||value.seq >= STRESS_PER_WRITER||value.check != ~(value.writer*STRESS_PER_WRITER + value.seq)){
+                fprintf(stderr,"concurrent: bad record at %zu\n",i);
+                slice_atomic_store(&failed,1,relaxed);
+                return NULL;
+            }
+        }
+        if(done){break;}
+        sched_yield();
+    }
+    return NULL;
+}
+
+static void stress_concurrent(void){
+    pthread_t writers[STRESS_WRITERS],readers[STRESS_READERS];
+    unsigned char* seen;
+    record value;
+    size_t i;
+    check(records_init(&shared_records));
+    slice_atomic_init(&writers_done,0);
+    for(i = 0;i < STRESS_READERS;i++){check(pthread_create(&readers[i],NULL,concurrent_reader,NULL) == 0);}
+    for(i = 0;i < STRESS_WRITERS;i++){check(pthread_create(&writers[i],NULL,concurrent_writer,(void*)i) == 0);}
+    for(i = 0;i < STRESS_WRITERS;i++){pthread_join(writers[i],NULL);}
+    for(i = 0;i < STRESS_READERS;i++){pthread_join(readers[i],NULL);}
+    check(records_length(&shared_records) == STRESS_WRITERS*STRESS_PER_WRITER);
+    seen = (unsigned char*)calloc(STRESS_WRITERS*STRESS_PER_WRITER,1);
+    check(seen != NULL);
+    for(i = 0;seen != NULL && i < records_length(&shared_records);i++){
+        check(records_bounded_at(&shared_records,i,&value));
+        check(value.writer < STRESS_WRITERS && value.seq < STRESS_PER_WRITER);
+        check(value.check == ~(value.writer*STRESS_PER_WRITER + value.seq));
+        check(!seen[value.writer*STRESS_PER_WRITER + value.seq]);
+        seen[value.writer*STRESS_PER_WRITER + value.seq] = 1;
+    }
+    free(seen);
+    records_destroy(&shared_records);
+}
+
+/*
+cow
+*/
+define_slice_cow(ints,int)
+
+static ints shared_ints;
+
+static void* cow_worker(void* arg){
+    int id = (int)(size_t)arg,round,i;
+    ints mine = ints_clone(&shared_ints);
+    for(round = 0;round < STRESS_COW_ROUNDS;round++){
+        ints copy = ints_clone(&mine);
+        ints_set(&copy,0,id);
+        check(ints_append(&copy,round));
+        check(ints_at(&copy,0) == id && ints_at(&copy,ints_length(copy) - 1) == round);
+        ints_destroy(&copy);
+    }
+    for(i = 0;i < (int)ints_length(mine);i++){check(ints_at(&mine,i) == i);}
+    ints_destroy(&mine);
+    return NULL;
+}
+
+static void stress_cow(void){
+    pthread_t threads[STRESS_COW_THREADS];
+    size_t i;
+    shared_ints = ints_make(16);
+    for(i = 0;i < 16;i++){check(ints_append(&shared_ints,(int)i));}
+    for(i = 0;i < STRESS_COW_THREADS;i++){check(pthread_create(&threads[i],NULL,cow_worker,(void*)i) == 0);}
+    for(i = 0;i < STRESS_COW_THREADS;i++){pthread_join(threads[i],NULL);}
+    check(!ints_is_shared(&shared_ints));
+    for(i = 0;i < 16;i++){check(ints_at(&shared_ints,i) == (int)i);}
+    ints_destroy(&shared_ints);
+}
+
+int main(void){
+    slice_atomic_init(&failed,0);
+    stress_spsc();
+    stress_concurrent();
+    stress_cow();
+    if(slice_atomic_load(&failed,relaxed)){return 1;}
+    printf("ok\n");
+    return 0;
+}